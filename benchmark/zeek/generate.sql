@@ -0,0 +1,150 @@
+-- Deterministic generator for the benchmark logs (see scripts/generate_benchmark_logs.sh).
+--
+-- Each table macro returns the lines of one Zeek TSV log of `n` records, header and footer included,
+-- in a single `line` column for COPY to write as is. Record values are derived from hash() of the
+-- record number, so every run of a given size produces the same bytes; `part` selects the slice of
+-- records a file of a multi-file log holds.
+
+-- One record: its values joined by tabs, with NULL written as the unset marker.
+CREATE OR REPLACE MACRO zeek_line(vals) AS
+    array_to_string(list_transform(vals, x -> coalesce(x, '-')), chr(9));
+
+-- Header (k < 8) and footer (k = 2^62) lines of a log.
+CREATE OR REPLACE MACRO zeek_frame(log_path, fields, types) AS TABLE
+    SELECT * FROM (VALUES
+        (0, '#separator \x09'),
+        (1, '#set_separator' || chr(9) || ','),
+        (2, '#empty_field' || chr(9) || '(empty)'),
+        (3, '#unset_field' || chr(9) || '-'),
+        (4, '#path' || chr(9) || log_path),
+        (5, '#open' || chr(9) || '2026-01-16-00-00-00'),
+        (6, '#fields' || chr(9) || array_to_string(fields, chr(9))),
+        (7, '#types' || chr(9) || array_to_string(types, chr(9))),
+        (4611686018427387904, '#close' || chr(9) || '2026-01-16-01-00-00')
+    ) t(k, line);
+
+-- The records of a part: record number `r`, hash `h`, Zeek timestamp `ts` (100 records a second from
+-- 2026-01-16 00:00:00 UTC) and the connection 4-tuple shared by all log types.
+CREATE OR REPLACE MACRO zeek_records(n, part) AS TABLE
+    SELECT
+        8 + i AS k,
+        r,
+        h,
+        printf('%d.%06d', 1768521600 + r // 100, (r % 100) * 10000 + h % 10000) AS ts,
+        'C' || hex(h) AS uid,
+        CASE WHEN h % 16 = 0 THEN '2001:db8::' || lower(hex((h >> 4) % 65536))
+             ELSE '10.' || ((h >> 4) % 4) || '.' || ((h >> 8) % 256) || '.' || ((h >> 16) % 256) END AS orig_h,
+        1024 + (h >> 24) % 64000 AS orig_p,
+        CASE WHEN h % 16 = 0 THEN '2001:db8:1::' || ((h >> 32) % 64)
+             ELSE '192.168.' || ((h >> 32) % 4) || '.' || ((h >> 36) % 64) END AS resp_h,
+        CASE WHEN (h >> 42) % 100 < 50 THEN 443 WHEN (h >> 42) % 100 < 75 THEN 80
+             WHEN (h >> 42) % 100 < 90 THEN 53 WHEN (h >> 42) % 100 < 99 THEN 8080 ELSE 22 END AS resp_p
+    FROM (SELECT i, part * n + i AS r, hash(part * n + i) AS h FROM range(n) t(i));
+
+CREATE OR REPLACE MACRO zeek_conn_log(n, part) AS TABLE
+    SELECT line FROM (
+        SELECT k, line FROM zeek_frame('conn',
+            ['ts', 'uid', 'id.orig_h', 'id.orig_p', 'id.resp_h', 'id.resp_p', 'proto', 'service', 'duration',
+             'orig_bytes', 'resp_bytes', 'conn_state', 'local_orig', 'local_resp', 'missed_bytes', 'history',
+             'orig_pkts', 'orig_ip_bytes', 'resp_pkts', 'resp_ip_bytes', 'tunnel_parents'],
+            ['time', 'string', 'addr', 'port', 'addr', 'port', 'enum', 'string', 'interval', 'count', 'count',
+             'string', 'bool', 'bool', 'count', 'string', 'count', 'count', 'count', 'count', 'set[string]'])
+        UNION ALL
+        SELECT k, zeek_line([
+            ts, uid, orig_h, orig_p::VARCHAR, resp_h, resp_p::VARCHAR,
+            CASE WHEN resp_p = 53 THEN 'udp' ELSE 'tcp' END,
+            CASE resp_p WHEN 443 THEN 'ssl' WHEN 80 THEN 'http' WHEN 53 THEN 'dns' WHEN 22 THEN 'ssh' END,
+            CASE WHEN h % 10 <> 0 THEN printf('%d.%06d', (h >> 12) % 30, (h >> 20) % 1000000) END,
+            ((h >> 20) % 100000)::VARCHAR, ((h >> 28) % 1000000)::VARCHAR,
+            ['SF', 'S0', 'REJ', 'RSTO', 'SH', 'OTH'][1 + (h >> 44) % 6],
+            CASE WHEN orig_h LIKE '10.%' THEN 'T' ELSE 'F' END, 'F', '0',
+            ['ShADadFf', 'S', 'ShR', 'Dd', 'ShADadfF'][1 + (h >> 47) % 5],
+            ((h >> 50) % 100)::VARCHAR, ((h >> 20) % 100000 + 40)::VARCHAR,
+            ((h >> 53) % 100)::VARCHAR, ((h >> 28) % 1000000 + 40)::VARCHAR,
+            CASE WHEN h % 50 = 0 THEN 'C' || hex(h >> 8) ELSE '(empty)' END
+        ]) FROM zeek_records(n, part)
+    ) ORDER BY k;
+
+CREATE OR REPLACE MACRO zeek_dns_log(n, part) AS TABLE
+    SELECT line FROM (
+        SELECT k, line FROM zeek_frame('dns',
+            ['ts', 'uid', 'id.orig_h', 'id.orig_p', 'id.resp_h', 'id.resp_p', 'proto', 'trans_id', 'rtt', 'query',
+             'qclass', 'qclass_name', 'qtype', 'qtype_name', 'rcode', 'rcode_name', 'AA', 'TC', 'RD', 'RA', 'Z',
+             'answers', 'TTLs', 'rejected'],
+            ['time', 'string', 'addr', 'port', 'addr', 'port', 'enum', 'count', 'interval', 'string', 'count',
+             'string', 'count', 'string', 'count', 'string', 'bool', 'bool', 'bool', 'bool', 'count',
+             'vector[string]', 'vector[interval]', 'bool'])
+        UNION ALL
+        SELECT k, zeek_line([
+            ts, uid, orig_h, orig_p::VARCHAR, resp_h, '53', 'udp', ((h >> 8) % 65536)::VARCHAR,
+            printf('0.%06d', (h >> 24) % 200000),
+            ['www', 'mail', 'api', 'cdn', 'login'][1 + (h >> 40) % 5] || '.host' || ((h >> 12) % 5000)
+                || '.example.com',
+            '1', 'C_INTERNET',
+            CASE WHEN h % 4 = 0 THEN '28' ELSE '1' END, CASE WHEN h % 4 = 0 THEN 'AAAA' ELSE 'A' END,
+            CASE WHEN h % 20 = 0 THEN '3' ELSE '0' END, CASE WHEN h % 20 = 0 THEN 'NXDOMAIN' ELSE 'NOERROR' END,
+            'F', 'F', 'T', 'T', '0',
+            CASE WHEN h % 20 = 0 THEN NULL
+                 ELSE '203.0.113.' || ((h >> 16) % 256) || ',203.0.113.' || ((h >> 24) % 256) END,
+            CASE WHEN h % 20 = 0 THEN NULL ELSE printf('%d.000000,%d.000000', (h >> 32) % 3600, (h >> 32) % 3600) END,
+            'F'
+        ]) FROM zeek_records(n, part)
+    ) ORDER BY k;
+
+CREATE OR REPLACE MACRO zeek_http_log(n, part) AS TABLE
+    SELECT line FROM (
+        SELECT k, line FROM zeek_frame('http',
+            ['ts', 'uid', 'id.orig_h', 'id.orig_p', 'id.resp_h', 'id.resp_p', 'trans_depth', 'method', 'host',
+             'uri', 'referrer', 'version', 'user_agent', 'origin', 'request_body_len', 'response_body_len',
+             'status_code', 'status_msg', 'info_code', 'info_msg', 'tags', 'username', 'password', 'proxied',
+             'orig_fuids', 'orig_filenames', 'orig_mime_types', 'resp_fuids', 'resp_filenames', 'resp_mime_types'],
+            ['time', 'string', 'addr', 'port', 'addr', 'port', 'count', 'string', 'string', 'string', 'string',
+             'string', 'string', 'string', 'count', 'count', 'count', 'string', 'count', 'string', 'set[enum]',
+             'string', 'string', 'set[string]', 'vector[string]', 'vector[string]', 'vector[string]',
+             'vector[string]', 'vector[string]', 'vector[string]'])
+        UNION ALL
+        SELECT k, zeek_line([
+            ts, uid, orig_h, orig_p::VARCHAR, resp_h, '80', (1 + h % 3)::VARCHAR,
+            CASE WHEN h % 10 = 0 THEN 'POST' ELSE 'GET' END,
+            'site' || ((h >> 12) % 500) || '.example.com',
+            '/' || ['index.html', 'api/v1/items', 'static/app.js', 'images/logo.png'][1 + (h >> 20) % 4]
+                || '?id=' || ((h >> 24) % 100000),
+            CASE WHEN h % 3 = 0 THEN 'https://site' || ((h >> 28) % 500) || '.example.com/' END,
+            '1.1',
+            ['Mozilla/5.0 (X11; Linux x86_64; rv:147.0) Gecko/20100101 Firefox/147.0',
+             'Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/145.0',
+             'curl/8.11.1'][1 + (h >> 36) % 3],
+            NULL, CASE WHEN h % 10 = 0 THEN ((h >> 40) % 10000)::VARCHAR ELSE '0' END,
+            ((h >> 16) % 500000)::VARCHAR,
+            CASE WHEN h % 25 = 0 THEN '404' ELSE '200' END, CASE WHEN h % 25 = 0 THEN 'Not Found' ELSE 'OK' END,
+            NULL, NULL, '(empty)', NULL, NULL, NULL,
+            NULL, NULL, NULL,
+            'F' || hex(h >> 4), NULL,
+            ['text/html', 'application/json', 'application/javascript', 'image/png'][1 + (h >> 20) % 4]
+        ]) FROM zeek_records(n, part)
+    ) ORDER BY k;
+
+CREATE OR REPLACE MACRO zeek_ssl_log(n, part) AS TABLE
+    SELECT line FROM (
+        SELECT k, line FROM zeek_frame('ssl',
+            ['ts', 'uid', 'id.orig_h', 'id.orig_p', 'id.resp_h', 'id.resp_p', 'version', 'cipher', 'curve',
+             'server_name', 'resumed', 'last_alert', 'next_protocol', 'established', 'ssl_history',
+             'cert_chain_fps', 'client_cert_chain_fps', 'sni_matches_cert'],
+            ['time', 'string', 'addr', 'port', 'addr', 'port', 'string', 'string', 'string', 'string', 'bool',
+             'string', 'string', 'bool', 'string', 'vector[string]', 'vector[string]', 'bool'])
+        UNION ALL
+        SELECT k, zeek_line([
+            ts, uid, orig_h, orig_p::VARCHAR, resp_h, '443',
+            CASE WHEN h % 5 = 0 THEN 'TLSv12' ELSE 'TLSv13' END,
+            ['TLS_AES_128_GCM_SHA256', 'TLS_AES_256_GCM_SHA384', 'TLS_CHACHA20_POLY1305_SHA256',
+             'TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256'][1 + (h >> 8) % 4],
+            ['x25519', 'secp256r1', 'x25519mlkem768'][1 + (h >> 12) % 3],
+            'site' || ((h >> 16) % 500) || '.example.com',
+            CASE WHEN h % 7 = 0 THEN 'T' ELSE 'F' END, NULL,
+            CASE WHEN h % 2 = 0 THEN 'h2' ELSE 'http/1.1' END,
+            CASE WHEN h % 40 = 0 THEN 'F' ELSE 'T' END,
+            'CsxknGIi',
+            lower(hex(h)) || lower(hex(h >> 1)) || ',' || lower(hex(h >> 2)) || lower(hex(h >> 3)),
+            '(empty)', 'T'
+        ]) FROM zeek_records(n, part)
+    ) ORDER BY k;
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Run the benchmarks in benchmark/zeek at several thread counts and report their throughput.
+
+Usage: benchmark_report.py <benchmark_runner> [--threads 1,2,4,8] [--pattern REGEX] [--out FILE]
+
+Each benchmark is run by DuckDB's benchmark_runner once per thread count. Throughput is derived from
+the logs its read_zeek call reads: MB/s counts uncompressed bytes (the same for the none, gzip and zstd
+copies of a log) and rows/s the records, so results for different compressions compare directly.
+"""
+
+import argparse
+import glob
+import os
+import re
+import statistics
+import subprocess
+import sys
+
+BENCHMARK_DIR = 'benchmark/zeek'
+READ_ZEEK_PATH = re.compile(r"read_zeek\('([^']+)'")
+COMPRESSION_DIR = re.compile(r'/(none|gzip|zstd)/')
+
+
+def uncompressed_glob(path):
+    """The glob of the uncompressed copies of the logs `path` matches."""
+    path = COMPRESSION_DIR.sub('/none/', path)
+    return re.sub(r'\.log\.(gz|zst)$', '.log', path)
+
+
+def data_size(path, cache):
+    """Uncompressed bytes and records of the logs `path` matches."""
+    pattern = uncompressed_glob(path)
+    if pattern not in cache:
+        files = glob.glob(pattern)
+        if not files:
+            sys.exit(f'No benchmark logs match {pattern}: run `make bench-data` first')
+        size = 0
+        rows = 0
+        for name in files:
+            size += os.path.getsize(name)
+            with open(name, 'rb') as f:
+                rows += sum(1 for line in f if not line.startswith(b'#'))
+        cache[pattern] = (size, rows)
+    return cache[pattern]
+
+
+def benchmark_data(name, cache):
+    with open(name) as f:
+        match = READ_ZEEK_PATH.search(f.read())
+    if not match:
+        return None
+    return data_size(match.group(1), cache)
+
+
+def run(runner, pattern, threads, out):
+    """Run the benchmarks matching `pattern`, returning the timings of each."""
+    subprocess.run([runner, pattern, f'--threads={threads}', f'--out={out}'], check=True)
+    timings = {}
+    with open(out) as f:
+        for line in f:
+            fields = line.rstrip('\n').split('\t')
+            if len(fields) != 3 or fields[0] == 'name':
+                continue
+            try:
+                timings.setdefault(fields[0], []).append(float(fields[2]))
+            except ValueError:
+                continue
+    return timings
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('runner', help='path to benchmark_runner')
+    parser.add_argument('--threads', default='1,2,4,8', help='comma-separated thread counts (default: 1,2,4,8)')
+    parser.add_argument('--pattern', default=BENCHMARK_DIR + '/.*', help='benchmarks to run (a regex)')
+    parser.add_argument('--out', default='bench_output.txt', help='timings file for benchmark_runner')
+    args = parser.parse_args()
+
+    cache = {}
+    results = []
+    for threads in [int(t) for t in args.threads.split(',')]:
+        for name, timings in sorted(run(args.runner, args.pattern, threads, args.out).items()):
+            data = benchmark_data(name, cache)
+            seconds = statistics.median(timings)
+            results.append((name, threads, seconds, data))
+
+    print(f"{'benchmark':<48} {'threads':>7} {'seconds':>9} {'MB/s':>10} {'rows/s':>14}")
+    for name, threads, seconds, data in results:
+        line = f'{os.path.basename(name):<48} {threads:>7} {seconds:>9.3f}'
+        if data and seconds > 0:
+            size, rows = data
+            line += f' {size / 1e6 / seconds:>10.1f} {rows / seconds:>14,.0f}'
+        print(line)
+
+
+if __name__ == '__main__':
+    main()
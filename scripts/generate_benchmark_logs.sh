@@ -0,0 +1,52 @@
+#!/bin/bash
+
+# Benchmark log generator
+
+# Usage: ./generate_benchmark_logs.sh <duckdb> [records] [files] [out_dir]
+# <duckdb>   : DuckDB CLI to run benchmark/zeek/generate.sql with (e.g. build/release/duckdb)
+# [records]  : Records per log type (default: 1000000)
+# [files]    : Number of files each log type is split into (default: 8)
+# [out_dir]  : Output directory (default: duckdb_benchmark_data/zeek)
+#
+# Writes conn, dns, http and ssl logs to <out_dir>/<compression>/<log>/<log>_<part>.log[.gz|.zst] for each
+# compression (none, gzip, zstd). The records only depend on [records] and [files], so the logs can be
+# regenerated to compare builds.
+
+set -e
+
+duckdb=$1
+records=${2:-1000000}
+files=${3:-8}
+out_dir=${4:-duckdb_benchmark_data/zeek}
+
+if [ -z "$duckdb" ]; then
+  echo "Usage: $0 <duckdb> [records] [files] [out_dir]" >&2
+  exit 1
+fi
+
+script_dir="$(dirname "$(readlink -f "$0")")"
+records_per_file=$(( (records + files - 1) / files ))
+
+sql=".read $script_dir/../benchmark/zeek/generate.sql"
+for log in conn dns http ssl; do
+  for compression in none gzip zstd; do
+    mkdir -p "$out_dir/$compression/$log"
+  done
+  for (( part = 0; part < files; part++ )); do
+    # Generate each file once, then write it with every compression.
+    sql+=$'\n'"CREATE OR REPLACE TEMP TABLE part AS SELECT line FROM zeek_${log}_log($records_per_file, $part);"
+    for compression in none gzip zstd; do
+      case $compression in
+        none) ext=log ;;
+        gzip) ext=log.gz ;;
+        zstd) ext=log.zst ;;
+      esac
+      # '|' never occurs in the generated lines, so COPY writes them unquoted.
+      sql+=$'\n'"COPY part TO '$out_dir/$compression/$log/${log}_$part.$ext' "
+      sql+="(FORMAT csv, HEADER false, DELIMITER '|', COMPRESSION $compression);"
+    done
+  done
+done
+
+echo "$sql" | "$duckdb"
+echo "Wrote $records_per_file records per file, $files files per log type to $out_dir"
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+
+namespace duckdb {
+
+//! Compressed container formats made of independently decompressible blocks. read_zeek can hand
+//! runs of such blocks to different threads without decompressing the file from the start.
+enum class ZeekBlockFormat : uint8_t {
+	//! Not block-splittable (plain file, or a single gzip/zstd stream).
+	NONE,
+	//! BGZF (bgzip): a series of gzip members, each carrying its compressed size in a 'BC' extra field.
+	BGZF,
+	//! Zstandard seekable format: independent frames followed by a seek table in a skippable frame.
+	SEEKABLE_ZSTD
+};
+
+//! One independently decompressible block of a block-compressed file.
+struct ZeekCompressedBlock {
+	//! Offset of the block within the compressed file.
+	idx_t offset;
+	//! Size of the block within the compressed file.
+	idx_t compressed_size;
+	//! Size of the block once decompressed.
+	idx_t decompressed_size;
+};
+
+//! Static methods for detecting and decoding block-compressed Zeek archives.
+class ZeekBlockCodec {
+public:
+	//! Detect whether `handle` (opened without decompression) holds a BGZF or seekable zstd file and,
+	//! if so, fill `blocks` with its block table in file order. Returns NONE and leaves `blocks`
+	//! empty for anything else, including truncated or otherwise inconsistent block tables.
+	static ZeekBlockFormat DetectBlocks(FileHandle &handle, vector<ZeekCompressedBlock> &blocks);
+
+	//! Decompress one block read from the file into `out` (grown if needed). Returns the number of
+	//! decompressed bytes written to the start of `out`.
+	static idx_t DecompressBlock(ZeekBlockFormat format, const ZeekCompressedBlock &block, const char *data,
+	                             vector<char> &out);
+};
+
+} // namespace duckdb
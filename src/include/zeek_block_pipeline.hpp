@@ -0,0 +1,74 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace duckdb {
+
+//! Reads (and, through DuckDB's compressed file wrappers, decompresses) a file ahead of its scanner
+//! thread into a small ring of fixed-size blocks. The reads run as tasks on DuckDB's scheduler, so
+//! that inflate and parsing of one file can use two of the query's threads, and never more threads
+//! than `SET threads` allows. The consuming scanner thread swaps filled blocks into its read buffer.
+//! When no task is reading (none was scheduled yet, or every scheduler thread is busy scanning), it
+//! reads the next block itself, so a scan never waits on a task that can't run.
+class ZeekBlockPipeline {
+public:
+	//! Schedules the first read-ahead task. `handle` must outlive the pipeline.
+	ZeekBlockPipeline(TaskScheduler &scheduler, FileHandle &handle, idx_t block_size, idx_t block_count);
+	//! Stops reading ahead, waiting for a read in flight to complete. Tasks still queued find the
+	//! pipeline gone and return.
+	~ZeekBlockPipeline();
+
+	//! Swap the next block into `buffer` and return its number of valid bytes, or 0 at EOF. The
+	//! previous contents of `buffer` are recycled into the ring. Rethrows any error raised by a
+	//! read-ahead task.
+	idx_t NextBlock(vector<char> &buffer);
+
+	//! The ring, shared with the read-ahead tasks (which may outlive the pipeline in the scheduler's
+	//! queue).
+	struct State {
+		struct FilledBlock {
+			vector<char> data;
+			idx_t size;
+		};
+
+		//! Null once the pipeline is destroyed.
+		FileHandle *handle;
+		idx_t block_size;
+
+		std::mutex lock;
+		//! Signalled when a read completes: a block is filled, or EOF or an error is reached.
+		std::condition_variable read_done;
+		std::deque<FilledBlock> filled_blocks;
+		vector<vector<char>> free_blocks;
+		//! True while a task or the consumer is reading from the handle; reads take turns so that
+		//! blocks are filled in file order.
+		bool reading = false;
+		//! True while a read-ahead task is queued and hasn't started reading yet.
+		bool task_pending = false;
+		//! True once a read hit EOF or an error.
+		bool done = false;
+		bool has_error = false;
+		ErrorData error;
+
+		//! Fill free blocks until none are left or reading has to stop. Called by the tasks.
+		void ReadAhead();
+	};
+
+private:
+	//! Queue a read-ahead task unless one is queued or reading, or there is nothing to read. Called
+	//! with state->lock held.
+	void ScheduleReadAhead();
+
+	TaskScheduler &scheduler;
+	unique_ptr<ProducerToken> token;
+	shared_ptr<State> state;
+};
+
+} // namespace duckdb
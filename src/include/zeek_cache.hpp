@@ -0,0 +1,29 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+struct ZeekScanBindData;
+
+//! The columnar cache behind read_zeek's `cache_dir`. The first scan of a log writes its rows to a
+//! Parquet file in the cache directory as it reads them, keyed on the log's path, size and
+//! modification time and the options the parsed columns depend on; later scans of the unchanged log
+//! read that file instead.
+class ZeekCache {
+public:
+	//! read_zeek's bind_replace: with `cache_dir`, look up the entries of the files the glob matches.
+	//! Returns a query reading the cached ones with read_parquet and the others with a read_zeek that
+	//! fills their entries, or null if none is cached (so that read_zeek fills them all itself) or
+	//! without `cache_dir`.
+	static unique_ptr<TableRef> BindReplace(ClientContext &context, TableFunctionBindInput &input);
+	//! Set up read_zeek's scan of `bind_data` to write each file to its entry in `cache_dir`.
+	static void BindWriteThrough(ClientContext &context, const string &cache_dir, bool replace_periods,
+	                             ZeekScanBindData &bind_data);
+};
+
+//! Get the zeek_convert table function
+TableFunction GetZeekConvertFunction();
+
+} // namespace duckdb
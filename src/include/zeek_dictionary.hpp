@@ -0,0 +1,59 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/string_map_set.hpp"
+#include "duckdb/common/types/string_heap.hpp"
+#include "duckdb/common/types/vector_buffer.hpp"
+#include "zeek_filter.hpp"
+
+namespace duckdb {
+
+//! One scanner thread's dictionary of the values of a low-cardinality VARCHAR column (a Zeek `enum`,
+//! or a column named in `dictionary_columns`). Each row of a chunk is stored as the index of its
+//! value's entry, and the chunk is emitted as a dictionary vector over the entries, so that a value
+//! is copied once per thread rather than once per row. The entries only ever grow, so that an
+//! entry's index, and the pushed-down filter's result on it, hold for the whole scan.
+struct ZeekColumnDictionary {
+	//! Past this many entries a column isn't low-cardinality after all: once a chunk ends with more,
+	//! the scanner writes the column as flat strings for the rest of the scan.
+	static constexpr idx_t MAX_ENTRIES = 1024;
+
+	ZeekColumnDictionary();
+
+	//! The entry for the value `ptr[0, len)`, added if new.
+	sel_t Lookup(const char *ptr, idx_t len);
+	//! The entry standing for NULL, added if new.
+	sel_t NullEntry();
+
+	//! Result of the column's pushed-down `filter` on `entry`, evaluated the first time it is asked for.
+	bool EvaluateFilter(const ZeekColumnFilter &filter, sel_t entry);
+
+	//! Make `vec` a dictionary vector over the entries whose rows are the entries set in `sel`, and
+	//! start a new selection for the next chunk.
+	void Emit(Vector &vec);
+
+	bool Overflowed() const {
+		return entries.size() > MAX_ENTRIES;
+	}
+
+	//! Rows of the current chunk, as entry indexes.
+	SelectionVector sel;
+	//! Entries of the rows of line batch `batch_number` (see ZeekLineBatch), by batch row, when the
+	//! column's pushed-down filter looked them up. Every row that passes the filters was looked up,
+	//! so that a column both filtered and projected is only looked up once per row.
+	vector<sel_t> batch_entries;
+	idx_t batch_number = DConstants::INVALID_INDEX;
+
+private:
+	//! Entry values (pointing into `heap`), with the NULL entry, if any, at null_entry.
+	vector<string_t> entries;
+	string_map_t<sel_t> lookup;
+	StringHeap heap;
+	idx_t null_entry = DConstants::INVALID_INDEX;
+	//! Per entry: 0 if the filter wasn't evaluated on it yet, else 1 + its result.
+	vector<uint8_t> filter_results;
+	//! The entries as of the last emitted chunk, shared with the vectors that reference them.
+	buffer_ptr<VectorChildBuffer> dictionary;
+};
+
+} // namespace duckdb
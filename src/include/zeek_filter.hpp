@@ -0,0 +1,62 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/planner/table_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/dynamic_filter.hpp"
+#include "zeek_tokenizer.hpp"
+
+namespace duckdb {
+
+//! A pushed-down filter on one column, compiled once for that column's type. Each row's field is
+//! parsed straight from its slice into a fixed-width value (or compared as raw bytes for VARCHAR)
+//! and checked against constants converted at compile time, with `IN` lists held in a hash set,
+//! so evaluating a row constructs no Values and allocates nothing.
+class ZeekColumnFilter {
+public:
+	virtual ~ZeekColumnFilter() = default;
+
+	//! Compile `filter` for a column of `type`. Filters that have no typed evaluator (e.g. on
+	//! INTERVAL columns, or with constants that don't convert to the column type) fall back to
+	//! parsing the field into a Value and evaluating the TableFilter on it, which must then
+	//! outlive the compiled filter.
+	static unique_ptr<ZeekColumnFilter> Compile(const TableFilter &filter, const LogicalType &type);
+
+	//! Evaluate the filter on a field that is present and not an unset/empty marker. A field that
+	//! fails to parse as the column type is treated as NULL.
+	virtual bool Evaluate(const FieldSlice &field) const = 0;
+
+	//! Result of the filter on a NULL field (unset/empty marker, or a field absent from the file).
+	bool EvaluateNull() const {
+		return null_result;
+	}
+
+protected:
+	bool null_result = false;
+};
+
+//! A filter whose constant DuckDB sets and tightens while the query runs, such as the boundary of an
+//! `ORDER BY ... LIMIT` (top-N). Compile leaves such filters out, as they only prune. Each
+//! scanner thread holds its own ZeekDynamicFilter and refreshes it once per chunk, so that rows are
+//! evaluated against a compiled copy without taking the filter's lock.
+class ZeekDynamicFilter {
+public:
+	ZeekDynamicFilter(shared_ptr<DynamicFilterData> data, LogicalType type);
+
+	//! The filter compiled from the current constant, recompiled if it changed since the last call.
+	//! Null while DuckDB hasn't set a constant yet.
+	optional_ptr<const ZeekColumnFilter> Refresh();
+
+	//! Append the dynamic filters that every row passing `filter` must pass: those at its top level,
+	//! under AND, or wrapped in optional filters.
+	static void Collect(const TableFilter &filter, vector<shared_ptr<DynamicFilterData>> &result);
+
+private:
+	shared_ptr<DynamicFilterData> data;
+	LogicalType type;
+	//! The copy of the constant that `compiled` was compiled from (and references).
+	unique_ptr<ConstantFilter> current;
+	unique_ptr<ZeekColumnFilter> compiled;
+};
+
+} // namespace duckdb
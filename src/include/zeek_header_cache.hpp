@@ -0,0 +1,48 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "zeek_reader.hpp"
+
+namespace duckdb {
+
+//! A parsed header in DuckDB's object cache.
+class ZeekHeaderCacheEntry : public ObjectCacheEntry {
+public:
+	explicit ZeekHeaderCacheEntry(ZeekHeader header_p)
+	    : header(make_shared_ptr<const ZeekHeader>(std::move(header_p))) {
+	}
+
+	shared_ptr<const ZeekHeader> header;
+
+	static string ObjectType() {
+		return "zeek_header";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	optional_idx GetEstimatedCacheMemory() const override;
+};
+
+//! Parses Zeek headers through the database's object cache, so that repeated queries over the same
+//! files skip header I/O. Entries are keyed on path, file size and modification time: a file that
+//! is rewritten or appended to is parsed afresh.
+class ZeekHeaderCache {
+public:
+	//! The header of the file at `path`, from the cache or parsed (and cached) now. Throws like
+	//! ZeekReader::ParseHeader if the file can't be opened or has no valid header.
+	static shared_ptr<const ZeekHeader> GetHeader(ClientContext &context, const string &path);
+
+	//! GetHeader for each of `paths`, fanned out over DuckDB's task scheduler. On return
+	//! headers[i] holds the header of paths[i], or is null with errors[i] set if GetHeader threw.
+	static void GetHeaders(ClientContext &context, const vector<string> &paths,
+	                       vector<shared_ptr<const ZeekHeader>> &headers, vector<ErrorData> &errors);
+
+	//! Set sizes[i] to the size of paths[i] for each i in `file_indexes`, fanned out like GetHeaders.
+	//! Files that can't be opened, or whose handles can't seek, keep their entries.
+	static void GetFileSizes(ClientContext &context, const vector<string> &paths, const vector<idx_t> &file_indexes,
+	                         vector<idx_t> &sizes);
+};
+
+} // namespace duckdb
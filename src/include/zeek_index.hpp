@@ -0,0 +1,86 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "zeek_block_codec.hpp"
+
+namespace duckdb {
+
+//! How the entries of a ZeekFileIndex address their part of the file.
+enum class ZeekIndexLayout : uint8_t {
+	//! A single gzip/zstd stream: one entry for the whole file, which can't be entered midway.
+	STREAM,
+	//! An uncompressed file: entries are byte ranges, like the scanner's split units.
+	BYTE_RANGES,
+	//! A BGZF / seekable zstd file: entries are runs of blocks, like the scanner's block-run units.
+	BLOCK_RUNS
+};
+
+//! One entry of a file's index. Like a ZeekScanUnit, the entry holds the rows of the lines whose
+//! first byte p satisfies start < p <= end (in decompressed stream offsets), where for block runs
+//! `start` and `end` are block indexes standing for the offsets at which those blocks begin.
+struct ZeekIndexEntry {
+	idx_t start;
+	idx_t end;
+	//! Number of data rows.
+	idx_t row_count;
+	//! Number of rows with a valid `ts`, and the range of those values (in microseconds). The range
+	//! is meaningless if ts_count is 0.
+	idx_t ts_count;
+	int64_t min_ts;
+	int64_t max_ts;
+};
+
+//! The sparse index of one Zeek log, as stored in its `.zidx` sidecar by zeek_build_index.
+struct ZeekFileIndex {
+	ZeekIndexLayout layout;
+	//! For BLOCK_RUNS, the file's block format.
+	ZeekBlockFormat block_format = ZeekBlockFormat::NONE;
+	//! Size and modification time of the log when it was indexed; the index is ignored once either
+	//! changes.
+	idx_t source_size = 0;
+	int64_t source_mtime = 0;
+	//! Entries in file order. They tile the file: the first starts at 0, each one starts where the
+	//! previous one ends, and the last ends at the file size (byte ranges) or block count (block runs).
+	//! A STREAM index has a single entry with start and end 0.
+	vector<ZeekIndexEntry> entries;
+
+	idx_t RowCount() const {
+		idx_t rows = 0;
+		for (auto &entry : entries) {
+			rows += entry.row_count;
+		}
+		return rows;
+	}
+};
+
+//! Builds, stores and loads the sidecar indexes that let read_zeek skip parts of a log that a `ts`
+//! filter rules out, and answer COUNT(*) without reading it.
+class ZeekIndex {
+public:
+	//! Path of the sidecar for the log at `path`.
+	static string SidecarPath(const string &path);
+	//! True if `path` names a sidecar, which globs over logs should leave out.
+	static bool IsSidecarPath(const string &path);
+
+	//! Read the whole log at `path` and index it, starting a new entry at the first line boundary
+	//! (or block boundary) once an entry holds `rows_per_entry` rows.
+	static ZeekFileIndex Build(ClientContext &context, const string &path, idx_t rows_per_entry);
+
+	//! Write `index` to the sidecar of the log at `path`, replacing any existing one.
+	static void Write(FileSystem &fs, const string &path, const ZeekFileIndex &index);
+
+	//! The index in the sidecar of the log at `path`, or null if there is none or it is stale.
+	//! Throws an IOException if the sidecar is malformed.
+	static shared_ptr<const ZeekFileIndex> Load(FileSystem &fs, const string &path);
+	//! Load for each of `paths`, remote ones only with `include_remote`. Each directory is listed
+	//! once to find its sidecars, rather than probing for the sidecar of every log.
+	static vector<shared_ptr<const ZeekFileIndex>> LoadAll(FileSystem &fs, const vector<string> &paths,
+	                                                       bool include_remote);
+};
+
+//! Get the zeek_build_index table function
+TableFunction GetZeekBuildIndexFunction();
+
+} // namespace duckdb
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+//! An IPv4 or IPv6 address (or network) in host order, as parsed from a Zeek `addr` or `subnet`.
+//! Ordering and equality follow DuckDB's ordering of the inet extension's INET values.
+struct ZeekInetAddress {
+	//! ZeekInet::IPV4 or ZeekInet::IPV6.
+	uint8_t ip_type;
+	//! The 128-bit address; IPv4 addresses only use the low 32 bits.
+	uint64_t upper;
+	uint64_t lower;
+	//! Prefix length: 32 / 128 for single addresses.
+	uint16_t mask;
+
+	bool operator==(const ZeekInetAddress &rhs) const {
+		return ip_type == rhs.ip_type && upper == rhs.upper && lower == rhs.lower && mask == rhs.mask;
+	}
+	bool operator!=(const ZeekInetAddress &rhs) const {
+		return !(*this == rhs);
+	}
+	bool operator<(const ZeekInetAddress &rhs) const {
+		if (ip_type != rhs.ip_type) {
+			return ip_type < rhs.ip_type;
+		}
+		if (upper != rhs.upper) {
+			return upper < rhs.upper;
+		}
+		if (lower != rhs.lower) {
+			return lower < rhs.lower;
+		}
+		return mask < rhs.mask;
+	}
+	bool operator>(const ZeekInetAddress &rhs) const {
+		return rhs < *this;
+	}
+	bool operator<=(const ZeekInetAddress &rhs) const {
+		return !(rhs < *this);
+	}
+	bool operator>=(const ZeekInetAddress &rhs) const {
+		return !(*this < rhs);
+	}
+};
+
+struct ZeekInetAddressHash {
+	size_t operator()(const ZeekInetAddress &address) const {
+		return std::hash<uint64_t>()(address.upper * 31 + address.lower) ^ (size_t(address.ip_type) << 8) ^
+		       address.mask;
+	}
+};
+
+//! Reads Zeek addresses directly into the inet extension's INET layout,
+//! STRUCT(ip_type UTINYINT, address HUGEINT, mask USMALLINT), instead of going through its
+//! VARCHAR cast.
+class ZeekInet {
+public:
+	static constexpr uint8_t IPV4 = 1;
+	static constexpr uint8_t IPV6 = 2;
+
+	//! Parse "a.b.c.d" or an IPv6 address (with "::" and an optional trailing dotted quad), with an
+	//! optional "/prefix". Returns false for anything else, so callers can fall back to the
+	//! extension's cast.
+	static bool Parse(const char *data, idx_t len, ZeekInetAddress &result);
+
+	//! True if `type` is the inet extension's INET type.
+	static bool IsInetType(const LogicalType &type);
+
+	//! True if `type` has the expected struct layout and the extension's VARCHAR cast agrees with
+	//! Parse on a set of probe values. Checked once at bind time; the cast path is used otherwise.
+	static bool SupportsNativeDecoding(ClientContext &context, const LogicalType &type);
+
+	//! Write `address` to row `row_idx` of a flat INET vector.
+	static void Write(Vector &vec, idx_t row_idx, const ZeekInetAddress &address);
+
+	//! Convert between INET Values and ZeekInetAddress.
+	static Value ToValue(const LogicalType &type, const ZeekInetAddress &address);
+	static ZeekInetAddress FromValue(const Value &value);
+
+	//! True if network `network` contains (or equals) `address`, like the extension's `>>=`.
+	static bool Contains(const ZeekInetAddress &network, const ZeekInetAddress &address);
+};
+
+} // namespace duckdb
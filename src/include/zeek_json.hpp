@@ -0,0 +1,70 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/string_map_set.hpp"
+#include "zeek_tokenizer.hpp"
+
+namespace duckdb {
+
+struct ZeekHeader;
+
+//! The fields of a Zeek JSON log by key, for ZeekJson::TokenizeLine.
+class ZeekJsonFieldMap {
+public:
+	explicit ZeekJsonFieldMap(vector<string> fields);
+
+	//! Index of the field named by the `len` bytes at `key`, or INVALID_INDEX if there is none. Zeek
+	//! writes the keys of every line in the same order, so `guess` (the field after the previous key)
+	//! is compared first.
+	idx_t Find(const char *key, idx_t len, idx_t guess) const;
+
+	idx_t FieldCount() const {
+		return fields.size();
+	}
+
+private:
+	vector<string> fields;
+	//! Keys reference the strings in `fields`, which are never modified.
+	string_map_t<idx_t> lookup;
+};
+
+//! Reads logs written with `LogAscii::use_json=T`: one JSON object per line, keyed by the same
+//! (dotted) field names as the TSV format, with unset fields left out. Such logs carry no types, so
+//! ParseHeader infers a header from the first lines; each line is then split into the same field
+//! slices the TSV tokenizer produces, which the scanner converts, filters and emits unchanged.
+class ZeekJson {
+public:
+	//! Elements of array values are joined with this separator (in place of a TSV log's
+	//! #set_separator) before being split into list elements.
+	static constexpr char LIST_SEPARATOR = '\x1f';
+	//! ParseHeader samples up to this many bytes, and at most SAMPLE_LINES lines, of a JSON log.
+	static constexpr idx_t SAMPLE_SIZE = 262144;
+	static constexpr idx_t SAMPLE_LINES = 1000;
+
+	//! True if `line`, read where a log's header was expected, starts a JSON log.
+	static bool IsJsonLine(const char *line, idx_t len);
+
+	//! Fill the fields and Zeek types of `header` from the complete lines in data[0, size), and mark it
+	//! as a JSON header. Fields are ordered as in the lines. Types follow the values: JSON booleans are
+	//! `bool`; numbers `count`, `int` or `double` (or `time` for the `ts` field, `interval` for
+	//! durations and round-trip times, and `port` for `_p` fields); strings `addr` or `subnet` if they
+	//! all parse as such, else `string`; and arrays `vector` of their elements' type.
+	static void InferHeader(const char *data, idx_t size, ZeekHeader &header);
+
+	//! A header holding the unset and empty markers of the slices TokenizeLine produces: the bytes 0xFF
+	//! and 0xFE, which never occur in UTF-8 text, so that no JSON value (also a string that is "-" or
+	//! "(empty)") can be taken for them.
+	static const ZeekHeader &Markers();
+
+	//! Split the JSON object in line[0, len) into `slices`, one per field of `fields`. A field the line
+	//! leaves out, or sets to null, gets the unset marker of Markers() (as does a null array element),
+	//! and an empty array its empty marker. Strings are unescaped and arrays joined with LIST_SEPARATOR
+	//! into `scratch`, which must not change until the slices are consumed; other values are sliced as
+	//! written. A string that is a lone marker byte (which isn't valid UTF-8) becomes U+FFFD. A
+	//! malformed line keeps the fields parsed before the error. Returns true if any slice points into
+	//! `scratch`.
+	static bool TokenizeLine(const char *line, idx_t len, const ZeekJsonFieldMap &fields, vector<FieldSlice> &slices,
+	                         vector<char> &scratch);
+};
+
+} // namespace duckdb
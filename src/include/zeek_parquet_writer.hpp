@@ -0,0 +1,111 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/execution/execution_context.hpp"
+#include "duckdb/function/copy_function.hpp"
+
+#include <mutex>
+
+namespace duckdb {
+
+//! A Parquet file for ZeekParquetWriter to write: the columns of the chunks passed to Write that it
+//! takes, with their names and types, and where its `ts` column is among them.
+struct ZeekParquetFileSpec {
+	//! Where the file goes; empty for a file that isn't written.
+	string path;
+	vector<idx_t> column_ids;
+	vector<string> names;
+	vector<LogicalType> types;
+	//! Position in column_ids of the TIMESTAMP_TZ column whose range is collected, or INVALID_INDEX.
+	idx_t ts_column = DConstants::INVALID_INDEX;
+	//! Value of the writer's source column in every row.
+	string source_value;
+	//! Number of scan units of the file that write to it.
+	idx_t unit_count = 0;
+};
+
+//! A file ZeekParquetWriter moved into place, and what was written to it.
+struct ZeekWrittenParquet {
+	idx_t file_idx = 0;
+	idx_t rows = 0;
+	//! Range of the file's ts column; NULL if it has none, or no values.
+	Value min_ts = Value(LogicalType::TIMESTAMP_TZ);
+	Value max_ts = Value(LogicalType::TIMESTAMP_TZ);
+	idx_t bytes = 0;
+};
+
+//! Writes the files of a read_zeek scan to Parquet while the scan reads them, through the parquet
+//! extension's COPY function. The units of a file share its writer and write in parallel, each unit's
+//! rows going to row groups of their own. A file is written under a temporary name and moved into
+//! place when its last unit ends; a file whose scan failed or stopped early (e.g. under a LIMIT) is
+//! removed instead, so that readers never see a partial file.
+class ZeekParquetWriter {
+public:
+	//! With a non-empty `source_column`, each file gets a VARCHAR column of that name holding its
+	//! spec's source_value. Throws if the parquet extension can't be loaded.
+	ZeekParquetWriter(ClientContext &context, vector<ZeekParquetFileSpec> files, const string &compression,
+	                  const string &source_column);
+	//! Removes the temporary files of the files that weren't moved into place.
+	~ZeekParquetWriter();
+
+	//! What a scanner thread keeps for the unit it writes.
+	struct UnitState {
+		idx_t file_idx = DConstants::INVALID_INDEX;
+		unique_ptr<LocalFunctionData> local_state;
+		//! The unit's rows, as the file's columns (referencing those of the scan).
+		DataChunk chunk;
+		idx_t rows = 0;
+		bool has_ts = false;
+		timestamp_tz_t min_ts;
+		timestamp_tz_t max_ts;
+	};
+
+	//! Start writing a unit of file `file_idx` with `unit`. Opens the file for its first unit.
+	void BeginUnit(ExecutionContext &context, idx_t file_idx, UnitState &unit);
+	//! Append the rows of `chunk`, which has the columns of every file spec's column_ids.
+	void Write(ExecutionContext &context, UnitState &unit, DataChunk &chunk);
+	//! End the unit that `unit` writes (if any), the file's last unit moving it into place.
+	void EndUnit(ExecutionContext &context, UnitState &unit);
+	//! Count a unit of file `file_idx` that was skipped (see ignore_file_errors) as ended: the file is
+	//! then left unwritten.
+	void AbandonUnit(idx_t file_idx);
+
+	//! Take a file that was moved into place and not taken yet. Returns false if there is none.
+	bool NextWritten(ZeekWrittenParquet &written);
+
+private:
+	struct File {
+		idx_t file_idx = 0;
+		ZeekParquetFileSpec spec;
+		//! Types of the file's columns, including the source column.
+		vector<LogicalType> types;
+		string temp_path;
+		unique_ptr<FunctionData> bind_data;
+		std::mutex lock;
+		//! Set once the temporary file is created, until it is moved into place or removed.
+		bool opened = false;
+		unique_ptr<GlobalFunctionData> global_state;
+		idx_t units_left = 0;
+		bool abandoned = false;
+		idx_t rows = 0;
+		bool has_ts = false;
+		timestamp_tz_t min_ts;
+		timestamp_tz_t max_ts;
+	};
+
+	//! Count one unit of `file` as ended, with its lock held. After the last one, the file is moved
+	//! into place, or removed if any unit was abandoned.
+	void EndFileUnit(File &file, bool abandoned);
+	//! Remove the temporary file of `file`, if it was created.
+	void Discard(File &file);
+
+	ClientContext &context;
+	const CopyFunction &copy_function;
+	const string source_column;
+	vector<unique_ptr<File>> files;
+	std::mutex written_lock;
+	vector<ZeekWrittenParquet> written_files;
+};
+
+} // namespace duckdb
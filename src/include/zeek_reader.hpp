@@ -2,11 +2,25 @@
 
 #include "duckdb.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/function/function_set.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/planner/table_filter.hpp"
+#include "duckdb/storage/arena_allocator.hpp"
+#include "zeek_block_codec.hpp"
+#include "zeek_block_pipeline.hpp"
+#include "zeek_dictionary.hpp"
+#include "zeek_filter.hpp"
+#include "zeek_index.hpp"
+#include "zeek_json.hpp"
+#include "zeek_parquet_writer.hpp"
+#include "zeek_scan_stats.hpp"
+#include "zeek_tokenizer.hpp"
 
 #include <atomic>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace duckdb {
@@ -31,13 +45,23 @@ struct ZeekHeader {
 	vector<string> types;
 	//! Number of header lines (for skipping when re-reading)
 	idx_t header_line_count = 0;
+	//! Average length (including the newline) of the lines sampled right after the header, or 0 if
+	//! none were. Used to estimate row counts from file sizes.
+	double sample_line_length = 0;
+	//! True for logs written as one JSON object per line, whose fields and types were inferred from
+	//! their first lines (see ZeekJson).
+	bool json = false;
+	//! Size and modification time of the (raw) file the header was parsed from, when parsed through
+	//! ZeekHeaderCache: the scan only reuses the header while they still match.
+	idx_t source_size = 0;
+	int64_t source_mtime = 0;
 };
 
 //! Static methods for parsing Zeek headers and converting types
 class ZeekReader {
 public:
-	//! Parse a Zeek header from a file handle
-	//! Returns the parsed header and positions the file handle at the first data line
+	//! Parse a Zeek header from a file handle, reading it in small buffered chunks. The handle is
+	//! left at an unspecified position past the header.
 	static ZeekHeader ParseHeader(FileHandle &file_handle);
 
 	static LogicalType ZeekTypeToDuckDBType(const string &zeek_type, bool use_inet = true,
@@ -45,26 +69,106 @@ public:
 
 	static string ParseSeparator(const string &sep_str);
 
-	static bool ReadLine(FileHandle &file_handle, string &line);
-
 	static string ExtractInnerType(const string &zeek_type);
 
 	//! Apply a single header line to a ZeekHeader. Returns true if the line was a directive
 	//! (i.e. starts with '#') and was consumed; false if it was a data line. Does not modify
 	//! `header` if it returns false.
 	static bool ApplyHeaderLine(const char *line, idx_t len, ZeekHeader &header);
+
+	//! Parse the rotation interval from a rotated log's file name, e.g.
+	//! `conn_20260116_09.00.00-10.00.00-0500.log.gz`. Returns false if the name has no such interval.
+	static bool ParseRotationInterval(const string &path, timestamp_tz_t &start, timestamp_tz_t &end);
+
+	//! Returns true if DuckDB's AUTO_DETECT would open this path through a decompressing wrapper.
+	//! Such files are scanned as one opaque stream; everything else can be split into byte ranges.
+	static bool IsCompressedPath(const string &path);
+
+	//! Parse a Zeek `time` or `interval` value (decimal seconds, which Zeek writes with six fractional
+	//! digits) into microseconds. Text of the form `[-]seconds[.fraction]` is parsed exactly in integer
+	//! arithmetic, truncating any digits past the sixth; anything else (exponents, whitespace, ...) goes
+	//! through the generic double cast. Returns false if the text isn't a number or is out of range.
+	static bool TryParseMicros(const char *data, idx_t len, int64_t &micros) {
+		idx_t pos = 0;
+		bool negative = false;
+		if (pos < len && (data[pos] == '-' || data[pos] == '+')) {
+			negative = data[pos] == '-';
+			pos++;
+		}
+		const idx_t int_start = pos;
+		int64_t seconds = 0;
+		while (pos < len && pos - int_start < MAX_EXACT_SECONDS_DIGITS && IsDigit(data[pos])) {
+			seconds = seconds * 10 + (data[pos] - '0');
+			pos++;
+		}
+		const idx_t int_digits = pos - int_start;
+		int64_t fraction = 0;
+		idx_t frac_digits = 0;
+		if (pos < len && data[pos] == '.') {
+			pos++;
+			for (; pos < len && IsDigit(data[pos]); pos++, frac_digits++) {
+				if (frac_digits < 6) {
+					fraction = fraction * 10 + (data[pos] - '0');
+				}
+			}
+		}
+		if (pos != len || int_digits + frac_digits == 0) {
+			return TryCastMicros(data, len, micros);
+		}
+		for (idx_t i = frac_digits; i < 6; i++) {
+			fraction *= 10;
+		}
+		micros = seconds * Interval::MICROS_PER_SEC + fraction;
+		if (negative) {
+			micros = -micros;
+		}
+		return true;
+	}
+
+	//! Parse a Zeek `time` value (fractional epoch seconds) as TIMESTAMP_TZ.
+	static bool TryParseTime(const char *data, idx_t len, timestamp_tz_t &result) {
+		int64_t micros;
+		if (!TryParseMicros(data, len, micros)) {
+			return false;
+		}
+		result = timestamp_tz_t(micros);
+		return true;
+	}
+
+	//! Parse a Zeek `interval` value (fractional seconds) as INTERVAL.
+	static bool TryParseInterval(const char *data, idx_t len, interval_t &result) {
+		int64_t micros;
+		if (!TryParseMicros(data, len, micros)) {
+			return false;
+		}
+		result = Interval::FromMicro(micros);
+		return true;
+	}
+
+private:
+	//! Whole-second digits TryParseMicros accepts before leaving a value to the double cast; 12 digits
+	//! of seconds still fit in int64 microseconds.
+	static constexpr idx_t MAX_EXACT_SECONDS_DIGITS = 12;
+
+	static bool IsDigit(char c) {
+		return c >= '0' && c <= '9';
+	}
+
+	//! The slow path of TryParseMicros: cast the text to a double and scale it.
+	static bool TryCastMicros(const char *data, idx_t len, int64_t &micros);
 };
 
 //! Compare two parsed headers for schema equivalence. Returns true if they describe the same
 //! Zeek log schema. On mismatch, populates `mismatch_reason` with a brief human-readable
 //! description of the first difference found and returns false. The fields compared are:
-//! `fields`, `types`, `separator`, `set_separator`, `unset_field`, `empty_field`. The
+//! `json`, `fields`, `types`, `separator`, `set_separator`, `unset_field`, `empty_field`. The
 //! `path` and `open_time` fields are intentionally ignored.
 bool SameSchema(const ZeekHeader &expected, const ZeekHeader &actual, string &mismatch_reason);
 
 //! Bind data for the read_zeek table function
 struct ZeekScanBindData : public TableFunctionData {
-	//! List of file paths (expanded from glob)
+	//! The glob (or list of globs) passed to read_zeek, and the file paths it expanded to
+	string pattern;
 	vector<string> file_paths;
 	//! Parsed header information. In strict mode this is file 0's header. In union mode the
 	//! `fields` and `types` vectors contain the union of all files' fields, in the order they
@@ -76,6 +180,9 @@ struct ZeekScanBindData : public TableFunctionData {
 	bool filename_column = false;
 	//! Whether to use INET type for addr/subnet (requires inet extension)
 	bool use_inet = true;
+	//! Whether INET columns are parsed straight into the inet extension's layout (see
+	//! ZeekInet::SupportsNativeDecoding) rather than batch-cast from VARCHAR.
+	bool native_inet = false;
 	//! Whether to union schemas across files. When true, the output schema is the union of all
 	//! files' fields and missing fields become NULL. When false (default) all files must have
 	//! identical schemas — any mismatch is an error.
@@ -83,84 +190,425 @@ struct ZeekScanBindData : public TableFunctionData {
 	//! Whether to ignore corrupted or unreadable files instead of throwing an error.
 	//! When true, files that cannot be opened or parsed are silently skipped.
 	bool ignore_file_errors = false;
+	//! Whether to decompress .gz/.zst files ahead of the scanner thread that parses them, in read-ahead
+	//! tasks on DuckDB's scheduler (see ZeekBlockPipeline).
+	bool parallel_decompression = false;
+	//! Bytes per read of the files (`buffer_size`), or 0 to choose per file: 64KB for local files, and
+	//! 8MB, read ahead by a ZeekBlockPipeline, for remote ones.
+	idx_t buffer_size = 0;
+	//! How far a record's `ts` may precede the start of its file's rotation interval. Files whose
+	//! interval lies entirely after a pushed-down `ts` filter are only skipped when this is set.
+	bool has_ts_lag = false;
+	interval_t ts_lag;
+	//! How far a record's `ts` may follow the end of its file's rotation interval. Files whose
+	//! interval lies entirely before a pushed-down `ts` filter are only skipped when this is set.
+	bool has_ts_lead = false;
+	interval_t ts_lead;
+	//! Whether VARCHAR values reference the scanner's read buffers (which are then kept alive by the
+	//! output vectors) instead of being copied into the vectors' string heaps.
+	bool zero_copy = true;
+	//! For each column, whether the scanner emits it as dictionary vectors (see ZeekColumnDictionary):
+	//! Zeek `enum` columns, and the VARCHAR columns named in `dictionary_columns`.
+	vector<bool> dictionary_columns;
+	//! Whether to use the sidecar indexes written by zeek_build_index, and for each file its index if
+	//! it has a current one (null otherwise).
+	bool use_index = true;
+	vector<shared_ptr<const ZeekFileIndex>> file_indexes;
+	//! Whether the first file, or any file in union mode, is a JSON log, whose fields are compared against
+	//! ZeekJson::Markers() rather than the bound header's markers.
+	bool json_files = false;
+	//! For each file, its size in bytes as bind learned it: from its index or the header bind parsed, or
+	//! else by statting the file (in parallel). DConstants::INVALID_INDEX for files that couldn't be
+	//! sized, and for remote compressed files, which are scanned whole and aren't statted.
+	vector<idx_t> file_sizes;
+	//! For the cardinality estimate, worked out once at bind: the rows of the indexed files, and the
+	//! (estimated decompressed) bytes of the others, where files that couldn't be sized count as
+	//! average-sized ones. scan_bytes_known is false if none of them could be sized.
+	idx_t indexed_rows = 0;
+	idx_t estimated_scan_bytes = 0;
+	bool scan_bytes_known = true;
+	//! Tail mode (`since` given): each log is read from the offset recorded for its log id (see
+	//! ZeekScanLocalState::current_log_id) by a previous call, a last line still missing its newline is
+	//! left for the next call, and the `log_id` and `next_offset` columns, at schema indexes
+	//! log_id_column and log_id_column + 1, tell the next call where to resume.
+	bool tail = false;
+	std::unordered_map<string, idx_t> since_offsets;
+	column_t log_id_column = DConstants::INVALID_INDEX;
+	//! Fraction of the scan units (whole files, or the ranges and block runs of split files) to read
+	//! (`sample`), chosen deterministically from their paths and offsets. Below 1, a `sample_weight`
+	//! column at schema index sample_weight_column gives the rows each sampled row stands for.
+	double sample = 1.0;
+	column_t sample_weight_column = DConstants::INVALID_INDEX;
+	//! For each file, its header if bind already parsed it (null otherwise), so that the scan can
+	//! skip the file's header lines without parsing them again.
+	vector<shared_ptr<const ZeekHeader>> file_headers;
 	//! When union_by_name=true: per-file inverse mapping. union_to_file_field[file_idx][union_col]
 	//! gives the field index within that file for the given union column, or idx_t(-1) if the
 	//! field is absent from this file. Empty when union_by_name=false.
 	vector<vector<idx_t>> union_to_file_field;
+	//! The columns' names, and their types with addresses as VARCHAR (as `inet=false` reads them).
+	vector<string> column_names;
+	vector<LogicalType> varchar_inet_types;
+	//! With `cache_dir` (for logs the cache doesn't have yet) and for zeek_convert: for each file, the
+	//! Parquet file its rows are written to as the scan reads them (see ZeekParquetWriter), or empty
+	//! for none. Such a scan takes no filters, converts every column to varchar_inet_types, writes it
+	//! with the file's own columns, and only then casts the projected columns to the output types.
+	vector<string> parquet_paths;
+	string parquet_compression = "zstd";
+	//! Name of a column holding each log's path to add to its Parquet file, or empty for none.
+	string parquet_source_column;
+
+	bool WritesParquet() const {
+		return !parquet_paths.empty();
+	}
 };
 
-//! A view into a contiguous span of bytes (no ownership)
-struct FieldSlice {
-	const char *ptr;
-	uint32_t len;
+//! One unit of scan work claimed by a scanner thread: a whole file, a byte range of a large
+//! uncompressed file, or a run of blocks of a block-compressed (BGZF / seekable zstd) file.
+//!
+//! A split unit owns every line whose first byte p satisfies start < p <= end (the first unit of a
+//! file also owns p == 0), i.e. every line whose preceding newline lies inside the unit. The thread
+//! that claims a unit with start > 0 discards bytes through the first newline, and keeps reading past
+//! `end` only to finish the line in progress.
+struct ZeekScanUnit {
+	//! Index into bind_data.file_paths.
+	idx_t file_idx;
+	//! For byte ranges, the start offset in the file. For block runs, the index of the first block in
+	//! the file's block table. 0 for whole-file units.
+	idx_t start;
+	//! For byte ranges, the end offset in the file. For block runs, one past the index of the last
+	//! block. DConstants::INVALID_INDEX for whole-file units (read until EOF).
+	idx_t end;
+	//! Block format of the file for block runs; NONE for whole files and byte ranges.
+	ZeekBlockFormat block_format;
+	//! Estimated number of (decompressed) bytes to scan, used to schedule large units first. 0 if
+	//! unknown.
+	idx_t size;
+
+	//! True if this unit is part of a split file. Split files are opened without DuckDB's
+	//! decompressing wrapper: byte ranges are uncompressed, and block runs are decoded per block.
+	bool IsRange() const {
+		return end != DConstants::INVALID_INDEX;
+	}
+};
+
+struct ZeekScanLocalState;
+struct ZeekColumnConverter;
+
+//! What a ZeekFieldConverter needs besides the field: the scan, and the output column it fills.
+struct ZeekConvertInput {
+	ZeekConvertInput(ClientContext &context_p, const ZeekScanBindData &bind_data_p, ZeekScanLocalState &lstate_p)
+	    : context(context_p), bind_data(bind_data_p), lstate(lstate_p) {
+	}
+
+	ClientContext &context;
+	const ZeekScanBindData &bind_data;
+	ZeekScanLocalState &lstate;
+	idx_t out_idx = 0;
+	const ZeekColumnConverter *column = nullptr;
+	//! Index in lstate.batch.buffers of the read buffer the row's line lies within, or INVALID_INDEX
+	//! if the line was copied into the batch's arena.
+	idx_t buffer_idx = DConstants::INVALID_INDEX;
+};
+
+//! Writes `field` (NULL if it is a null marker) to row `row` of `vec`.
+typedef void (*ZeekFieldConverter)(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field);
+
+//! How one output column is filled, resolved once per scan so that the per-row loop doesn't look at
+//! column types or null markers.
+struct ZeekColumnConverter {
+	enum class Source : uint8_t { FIELD, FILENAME, LOG_ID, NEXT_OFFSET, SAMPLE_WEIGHT };
+
+	Source source = Source::FIELD;
+	column_t schema_col = 0;
+	//! True if the column isn't handled natively: `convert` collects the fields in a vector of
+	//! `cast_type` (VARCHAR, or LIST(VARCHAR) for lists of such elements) that is cast to the
+	//! column's type at the end of the chunk.
+	bool cast_buffer = false;
+	LogicalType cast_type = LogicalType::VARCHAR;
+	//! Converter for the column's fields, instantiated for its type and the header's null markers.
+	ZeekFieldConverter convert = nullptr;
+	//! For LIST columns, the converter for their elements.
+	ZeekFieldConverter convert_element = nullptr;
 };
 
 //! Global state for the read_zeek table function. Shared across all parallel scanner threads —
 //! contains only read-only or atomic data.
 struct ZeekScanGlobalState : public GlobalTableFunctionState {
-	//! Atomic counter for the next file index to claim from bind_data.file_paths.
-	std::atomic<idx_t> next_file_idx {0};
-	//! Total number of files (cached from bind_data, used for MaxThreads).
-	idx_t total_files = 0;
+	//! Work units, in file order until the first scanner thread starts (see `preserve_order`). Files
+	//! that can be split produce several units, which threads claim independently.
+	vector<ZeekScanUnit> units;
+	//! Atomic counter for the next unit index to claim from `units`.
+	std::atomic<idx_t> next_unit_idx {0};
+	//! Estimated bytes to scan across all units, and the bytes the scanner threads have reported
+	//! reading so far (for progress reporting).
+	idx_t total_scan_size = 0;
+	std::atomic<idx_t> bytes_scanned {0};
+	//! Where the scanner threads add their counters, for zeek_scan_stats() and EXPLAIN ANALYZE.
+	shared_ptr<ZeekScanStats> stats;
+	//! Per file: the block table of block-compressed files split into block runs, else empty.
+	vector<vector<ZeekCompressedBlock>> file_blocks;
 
 	//! Projection pushdown: for each output column index, the schema column index it maps to.
 	//! A value of data_col_count means the filename virtual column.
 	vector<column_t> projected_schema_cols;
 	//! True if no columns are projected (e.g. COUNT(*)) — skip all parsing
 	bool count_only = false;
+	//! With count_only, the rows of indexed files (which get no units) that are still to be emitted.
+	std::atomic<idx_t> indexed_row_count {0};
+
+	//! True if the pipeline's sink needs chunks in batch order (e.g. to keep insertion order). The
+	//! first thread to initialize decides, as init_local is the first place that sees the sink:
+	//! otherwise the units are sorted largest first. With it set, units are handed out in file order
+	//! and a chunk never spans two of them, so that numbering chunks by unit (their batch index)
+	//! orders them and DuckDB can keep that order while scanning in parallel. Chunks of indexed rows
+	//! are numbered 0 to indexed_batch_count - 1 in claim order, and those of unit i get
+	//! indexed_batch_count + i.
+	mutex order_lock;
+	bool order_decided = false;
+	bool preserve_order = false;
+	idx_t indexed_batch_count = 0;
+	std::atomic<idx_t> next_indexed_batch {0};
+
+	//! With `sample`, the units the sample was drawn from divided by those kept: the value of the
+	//! `sample_weight` column.
+	double sample_weight = 1.0;
 
 	//! Pushed-down filters from DuckDB. The map key is the index into projected_schema_cols
 	//! (i.e. the output column index), NOT the schema column index. Null if no filters pushed down.
 	optional_ptr<TableFilterSet> filters;
+	//! `filters`, compiled for evaluation on field slices (see ZeekColumnFilter).
+	struct ColumnFilter {
+		//! Schema column index, or data_col_count for the filename virtual column.
+		column_t schema_col;
+		unique_ptr<ZeekColumnFilter> filter;
+	};
+	vector<ColumnFilter> column_filters;
+	//! The dynamic filters among `filters` (see ZeekDynamicFilter), of which each thread keeps its own
+	//! compiled copy.
+	struct DynamicColumnFilter {
+		column_t schema_col;
+		LogicalType type;
+		shared_ptr<DynamicFilterData> data;
+	};
+	vector<DynamicColumnFilter> dynamic_filters;
 
-	//! For each output column index, true if its type isn't natively handled and needs the
-	//! batched cast path (i.e. each thread should allocate a temp VARCHAR vector for it).
-	vector<bool> needs_cast_buffer;
+	//! For each output column index, how it is filled (see ZeekColumnConverter). Threads allocate a
+	//! temp vector for each column with cast_buffer set. A scan that writes Parquet has one for each
+	//! data column instead, filling the thread's parquet_chunk.
+	vector<ZeekColumnConverter> converters;
+	//! Writes the files to bind_data.parquet_paths, if the scan does.
+	unique_ptr<ZeekParquetWriter> parquet_writer;
 
 	idx_t MaxThreads() const override {
-		return total_files == 0 ? 1 : total_files;
+		return units.empty() ? 1 : units.size();
 	}
 };
 
+//! A block of decompressed file bytes. VARCHAR output vectors reference it as an auxiliary string
+//! buffer, so that their string_t values can point straight into it; a buffer still held by an
+//! output vector is never refilled.
+struct ZeekReadBuffer : public VectorBuffer {
+	explicit ZeekReadBuffer(idx_t size) : VectorBuffer(VectorBufferType::OPAQUE_BUFFER), bytes(size) {
+	}
+
+	vector<char> bytes;
+};
+
+//! Data lines of the current unit that a scanner thread reads, filters and converts together: up to
+//! a chunk's worth of lines is tokenized up to the filter fields, the filters are evaluated column by
+//! column into `sel`, and only the rows that pass are split further and converted. A row's field
+//! slices stay valid until the batch is released, because the read buffers its lines lie within are
+//! held in `buffers` (and so not refilled, see AcquireReadBuffer) and any other line is copied into
+//! `arena` together with the JSON values unescaped from it.
+struct ZeekLineBatch {
+	ZeekLineBatch() : arena(Allocator::DefaultAllocator()), sel(STANDARD_VECTOR_SIZE) {
+	}
+
+	struct Row {
+		const char *line_ptr;
+		idx_t line_len;
+		//! Number of the row's field slices (see `slices`).
+		idx_t field_count;
+		//! Index in `buffers` of the read buffer the line lies within, or INVALID_INDEX.
+		idx_t buffer_idx;
+		//! In tail mode, the offset after the line (for the next_offset column).
+		idx_t next_offset;
+	};
+	vector<Row> rows;
+	//! Field slices of the rows, `stride` (the current file's max_needed_fields) per row: those of row
+	//! r start at slices[r * stride].
+	vector<FieldSlice> slices;
+	idx_t stride = 0;
+	vector<buffer_ptr<ZeekReadBuffer>> buffers;
+	ArenaAllocator arena;
+	//! The rows that pass the filters, and their number.
+	SelectionVector sel;
+	idx_t selected = 0;
+	//! Batches read so far by the thread, identifying the current one to the dictionaries.
+	idx_t number = 0;
+};
+
 //! Per-thread local state. One per parallel scanner thread.
 struct ZeekScanLocalState : public LocalTableFunctionState {
 	//! Currently-open file (or null between files).
 	unique_ptr<FileHandle> file_handle;
+	//! Read-ahead pipeline reading from file_handle, when parallel_decompression is enabled and the
+	//! current file is compressed, or the file is remote. Declared after file_handle so that it is
+	//! destroyed (and its read in flight finished) first.
+	unique_ptr<ZeekBlockPipeline> pipeline;
 	//! Path of the currently-open file (for filename column).
 	string current_file_path;
 	//! Index into bind_data.file_paths for the currently-open file.
 	idx_t current_file_idx = 0;
+	//! In tail mode: the current file's log id (its `#path` and `#open` values, which a log keeps when it
+	//! is rotated and compressed, or its path if it has no `#open`), and the offset to resume it from.
+	//! Lines that end at or before that offset are left out.
+	string current_log_id;
+	idx_t resume_offset = 0;
+	//! Offset, in the file's decompressed stream, of the stream buffer_file_offset counts from: the
+	//! start of the unit's first block for block runs, else 0.
+	idx_t unit_stream_offset = 0;
+	//! Offset (in the stream read_buffer is filled from) past which the current unit owns no more
+	//! lines. ReadLineBuffered reports EOF once the next line would start after this offset. For
+	//! block runs this is only known once reading crosses the unit's last block.
+	idx_t range_end = DConstants::INVALID_INDEX;
+
+	//! When the current unit is a block run: the file's block format and block table, the next block
+	//! to decode, and the first block past the unit (INVALID_INDEX while the header is parsed).
+	ZeekBlockFormat block_format = ZeekBlockFormat::NONE;
+	optional_ptr<const vector<ZeekCompressedBlock>> blocks;
+	idx_t next_block = 0;
+	idx_t unit_block_end = DConstants::INVALID_INDEX;
+	//! Raw bytes of the block being decoded.
+	vector<char> compressed_buffer;
 	//! True when this thread has no more files to process.
 	bool finished = false;
+	//! Batch index of the chunk being emitted (see ZeekScanGlobalState::preserve_order).
+	idx_t batch_index = 0;
+	//! This thread's copies of gstate.dynamic_filters, and those that had a constant when the current
+	//! chunk began.
+	vector<unique_ptr<ZeekDynamicFilter>> dynamic_filters;
+	struct ActiveDynamicFilter {
+		column_t schema_col;
+		optional_ptr<const ZeekColumnFilter> filter;
+	};
+	vector<ActiveDynamicFilter> active_dynamic_filters;
 
 	//! For each schema column index (in the bound output schema), the index of that field in the
 	//! currently-open file's row layout — or idx_t(-1) if the field is absent from this file
 	//! (only possible in union_by_name mode). In strict mode this is always the identity mapping.
 	//! Re-populated each time OpenNextFile claims a new file.
 	vector<idx_t> field_lookup;
+	//! Number of leading fields of the current file that the projection and filters touch (one past
+	//! the highest needed field index). Lines are only tokenized this far.
+	idx_t max_needed_fields = DConstants::INVALID_INDEX;
+	//! Number of leading fields the pushed-down filters touch (max_needed_fields without filters, and
+	//! for JSON logs). Lines are first tokenized this far, and only the rows that pass the filters the
+	//! rest of the way, so that rows filtered out don't pay for splitting the fields after.
+	idx_t filter_fields = DConstants::INVALID_INDEX;
 
-	//! Buffered I/O: raw bytes read from the file.
-	vector<char> read_buffer;
+	//! Buffered I/O: raw bytes read from the file, `read_size` bytes at a time.
+	buffer_ptr<ZeekReadBuffer> read_buffer;
+	idx_t read_size = 0;
+	//! Previous read buffers, reused for refills once no output vector references them.
+	vector<buffer_ptr<ZeekReadBuffer>> spare_read_buffers;
 	idx_t buffer_pos = 0;
 	idx_t buffer_size = 0;
+	//! Offset of read_buffer[0] within the stream it is filled from: the (decompressed) file, or for
+	//! block runs the concatenation of the decoded blocks starting at the unit's first block.
+	idx_t buffer_file_offset = 0;
 	bool eof_reached = false;
+	//! Bytes read into read_buffer since they were last added to gstate.bytes_scanned.
+	idx_t unreported_bytes = 0;
 
-	//! Current line, accumulated across buffer refills if needed.
+	//! Current line (without its newline): points into read_buffer when the line lies within it,
+	//! or into line_buffer when it had to be accumulated across buffer refills. Valid until the
+	//! next read, which is why data lines are added to `batch` as they are read.
+	const char *line_ptr = nullptr;
+	idx_t line_len = 0;
+	//! Backing storage for lines that span a buffer refill.
 	vector<char> line_buffer;
-	//! When true, line_buffer holds a line that was already read but not yet consumed by the
-	//! caller (e.g., the first data line peeked at by the per-file header parser). The next
-	//! call to ReadLineBuffered will return this line as-is and clear the flag.
+	//! True if the current line lies within read_buffer, so that its VARCHAR fields can reference it
+	//! (see ZeekReadBuffer) rather than being copied.
+	bool line_in_read_buffer = false;
+	//! For each output column, the read buffer most recently attached to its vector (or to its list
+	//! child vector) during the current chunk.
+	vector<const ZeekReadBuffer *> attached_read_buffers;
+	//! When true, the current line was already read but not yet consumed by the caller (e.g., the
+	//! first data line peeked at by the per-file header parser). The next call to ReadLineBuffered
+	//! will return this line as-is and clear the flag.
 	bool has_pending_line = false;
-	//! Field slices into line_buffer (reused per row).
+	//! COUNT(*) fast path (see CountRowsBuffered): the read position is within a line that was
+	//! already counted, or just past a '\r' starting a line that is a row unless a newline follows.
+	bool count_mid_line = false;
+	bool count_pending_cr = false;
+	//! Field slices into the current line (reused per row).
 	vector<FieldSlice> field_slices;
-	//! Element slices for LIST values (reused per LIST cell).
-	vector<FieldSlice> list_element_slices;
+	//! Slices of the fields after filter_fields of a batch row that passes the filters.
+	vector<FieldSlice> remaining_slices;
+	//! True if the current file is a JSON log (see ZeekJson), whose lines are split by key into
+	//! `json_fields` slices instead of at a separator.
+	bool json = false;
+	unique_ptr<ZeekJsonFieldMap> json_fields;
+	//! Unescaped strings and joined arrays of the current JSON line.
+	vector<char> json_scratch;
+	//! The header whose unset and empty markers the current file's fields are compared against: the
+	//! bound header for TSV logs, ZeekJson::Markers() for JSON logs.
+	const ZeekHeader *markers = nullptr;
 
 	//! Per-thread cast temp vectors, one per output column. nullptr for native columns.
 	vector<unique_ptr<Vector>> cast_temp_vecs;
+	//! For each output column, the number of list elements it had in the previous chunk, reserved
+	//! up front in the next one (0 for columns that aren't lists).
+	vector<idx_t> list_reserve;
+	//! For each schema column, this thread's dictionary if the column is dictionary-encoded and
+	//! projected or filtered (null otherwise, and once the column turns out not to be low-cardinality).
+	vector<unique_ptr<ZeekColumnDictionary>> dictionaries;
+	//! The line batch being converted into the current chunk.
+	ZeekLineBatch batch;
+	//! When the scan writes Parquet: the current chunk's rows with every data column (see
+	//! ZeekScanGlobalState::converters), the unit being written, and the thread's execution context
+	//! (from init_local, whose pipeline executor also owns this state) it is written in.
+	DataChunk parquet_chunk;
+	ZeekParquetWriter::UnitState parquet_unit;
+	unique_ptr<ExecutionContext> execution_context;
+
+	//! This thread's counters since the last chunk (see ZeekScanCounters).
+	ZeekScanCounters counters;
+	//! True if the current unit is read from an uncompressed file, whose bytes read are also the
+	//! bytes read from storage.
+	bool uncompressed_unit = false;
+	//! True if the current unit's file changed since bind parsed its header.
+	bool file_changed = false;
+};
+
+//! read_zeek's scan, for table functions that run it themselves (zeek_convert).
+class ZeekScan {
+public:
+	//! The sorted paths `files` (a glob, or a list of globs) matches, leaving out sidecar indexes.
+	//! Throws if there are none.
+	static vector<string> GlobFiles(FileSystem &fs, const Value &files);
+
+	//! read_zeek's bind, over `files` with the named `parameters`. With `separate_types`, a field
+	//! whose type differs between files in union mode gets a column for each of its types rather than
+	//! failing the bind.
+	static unique_ptr<ZeekScanBindData> Bind(ClientContext &context, const Value &files,
+	                                         const named_parameter_map_t &parameters, bool separate_types,
+	                                         vector<LogicalType> &return_types, vector<string> &names);
+	//! read_zeek's init_global, for the schema columns `column_ids` and pushed-down `filters`.
+	static unique_ptr<ZeekScanGlobalState> InitGlobal(ClientContext &context, const ZeekScanBindData &bind_data,
+	                                                  const vector<column_t> &column_ids,
+	                                                  optional_ptr<TableFilterSet> filters);
+	//! read_zeek's init_local.
+	static unique_ptr<ZeekScanLocalState> InitLocal(ExecutionContext &context, const ZeekScanBindData &bind_data,
+	                                                ZeekScanGlobalState &gstate);
+	//! read_zeek's function: fill `output` with the next rows, or with none once the thread is done.
+	static void Scan(ClientContext &context, const ZeekScanBindData &bind_data, ZeekScanGlobalState &gstate,
+	                 ZeekScanLocalState &lstate, DataChunk &output);
 };
 
-//! Get the read_zeek table function
-TableFunction GetZeekScanFunction();
+//! Get the read_zeek table functions, over a glob and over a list of globs
+TableFunctionSet GetZeekScanFunction();
 
 } // namespace duckdb
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context_state.hpp"
+
+#include <chrono>
+#include <mutex>
+
+namespace duckdb {
+
+//! What a read_zeek scan did. Each thread counts into its own ZeekScanCounters and adds them to the
+//! scan's ZeekScanStats once per chunk.
+struct ZeekScanCounters {
+	//! Scan units (files, byte ranges or block runs) opened, and those skipped by ignore_file_errors.
+	idx_t scan_units = 0;
+	idx_t files_skipped = 0;
+	//! Bytes read from storage: compressed blocks or streams, or the uncompressed file.
+	idx_t compressed_bytes = 0;
+	//! Bytes of (decompressed) log read into the read buffers.
+	idx_t decompressed_bytes = 0;
+	//! Lines read, of which comment lines (e.g. #close) and rows rejected by pushed-down filters.
+	idx_t lines_read = 0;
+	idx_t comment_lines = 0;
+	idx_t rows_filtered = 0;
+	idx_t rows_emitted = 0;
+	//! Nanoseconds spent reading (and decompressing) blocks, splitting and tokenizing lines,
+	//! evaluating filters, converting fields and casting non-native columns. Tokenizing, filtering and
+	//! converting are timed once per line batch (see ZeekLineBatch).
+	uint64_t read_ns = 0;
+	uint64_t tokenize_ns = 0;
+	uint64_t filter_ns = 0;
+	uint64_t convert_ns = 0;
+	uint64_t cast_ns = 0;
+
+	void Add(const ZeekScanCounters &other);
+
+	static inline uint64_t Now() {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		                                 std::chrono::steady_clock::now().time_since_epoch())
+		                                 .count());
+	}
+};
+
+//! The totals of one read_zeek scan.
+class ZeekScanStats {
+public:
+	explicit ZeekScanStats(string pattern_p) : pattern(std::move(pattern_p)) {
+	}
+
+	void Add(const ZeekScanCounters &counters);
+	ZeekScanCounters Totals() const;
+
+	const string pattern;
+
+private:
+	mutable std::mutex lock;
+	ZeekScanCounters totals;
+};
+
+//! The scans of the most recent query that ran read_zeek in a connection, for zeek_scan_stats().
+class ZeekScanStatsRegistry : public ClientContextState {
+public:
+	static ZeekScanStatsRegistry &Get(ClientContext &context);
+
+	void QueryBegin(ClientContext &context) override;
+
+	//! Start recording a scan of `pattern` in the current query.
+	shared_ptr<ZeekScanStats> BeginScan(const string &pattern);
+	vector<shared_ptr<ZeekScanStats>> Scans() const;
+
+private:
+	mutable std::mutex lock;
+	//! Incremented by QueryBegin; `scans` belong to query `scans_query`.
+	idx_t query = 0;
+	idx_t scans_query = 0;
+	vector<shared_ptr<ZeekScanStats>> scans;
+};
+
+//! Get the zeek_scan_stats table function
+TableFunction GetZeekScanStatsFunction();
+
+} // namespace duckdb
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//! A view into a contiguous span of bytes (no ownership)
+struct FieldSlice {
+	const char *ptr;
+	uint32_t len;
+};
+
+//! Vectorized field splitting. Builds newline and separator bitmasks for 64 bytes at a time (AVX2 or
+//! SSE2 on x86-64, NEON on AArch64, chosen once at runtime) and walks the set bits, so that finding
+//! the end of a line and the boundaries of its fields take a single pass over the bytes.
+class ZeekTokenizer {
+public:
+	//! Split the line starting at `data` into `slices` (cleared first) at each `separator`, stopping
+	//! at the first '\n' within `len` bytes. Returns the offset of that newline, whose field slices
+	//! are complete; or `len` if there is none, in which case the last slice runs to the end of the
+	//! span (which is also how a span that is known not to contain a newline is tokenized).
+	//! At most `max_fields` slices are produced: once that many fields have been split off, the rest
+	//! of the line is only searched for its newline.
+	static idx_t TokenizeLine(const char *data, idx_t len, char separator, vector<FieldSlice> &slices,
+	                          idx_t max_fields = DConstants::INVALID_INDEX);
+
+	//! Count the data rows among the lines that start within data[0, len), where data[0] starts a
+	//! line: lines that are neither empty (also after dropping a trailing '\r') nor start with '#'.
+	//! Only the newlines and the first byte of each line are looked at. Counting stops before the
+	//! row after the first `max_rows`. `consumed` is set to where counting stopped: `len`; the start
+	//! of the next row once `max_rows` rows were counted; or, with fewer rows, `len - 1` if the
+	//! last byte is a '\r' that starts a line and it takes the next byte to tell whether that line
+	//! is empty.
+	static idx_t CountRows(const char *data, idx_t len, idx_t max_rows, idx_t &consumed);
+
+	//! Number of occurrences of `separator` in data[0, len) (e.g. the set separators of a list cell,
+	//! which has one more element than that).
+	static idx_t CountSeparators(const char *data, idx_t len, char separator);
+
+	//! Name of the kernel selected for this CPU ("avx2", "sse2", "neon" or "scalar").
+	static const char *KernelName();
+};
+
+} // namespace duckdb
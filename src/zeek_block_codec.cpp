@@ -0,0 +1,256 @@
+#include "zeek_block_codec.hpp"
+#include "duckdb/common/gzip_file_system.hpp"
+
+#include <cstring>
+
+// DuckDB bundles zstd (in the duckdb_zstd namespace); seekable zstd support depends on its header
+// being on the include path. Likewise miniz (duckdb_miniz), which inflates BGZF blocks in place.
+#if defined(__has_include)
+#if __has_include("zstd.h")
+#include "zstd.h"
+#define ZEEK_HAVE_ZSTD 1
+#endif
+#if __has_include("miniz.hpp")
+#include "miniz.hpp"
+#define ZEEK_HAVE_MINIZ 1
+#endif
+#endif
+
+namespace duckdb {
+
+static constexpr uint8_t GZIP_FLAG_EXTRA = 0x04;
+//! ID1, ID2, CM, FLG, MTIME(4), XFL, OS + XLEN(2).
+static constexpr idx_t GZIP_FIXED_HEADER_SIZE = 12;
+//! CRC32 + ISIZE.
+static constexpr idx_t GZIP_TRAILER_SIZE = 8;
+#ifndef ZEEK_HAVE_MINIZ
+//! A gzip member header without optional fields (FLG = 0, OS = unknown).
+static const char MINIMAL_GZIP_HEADER[] = "\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff";
+static constexpr idx_t MINIMAL_GZIP_HEADER_SIZE = 10;
+#endif
+
+static constexpr uint32_t ZSTD_SEEK_TABLE_SKIPPABLE_MAGIC = 0x184D2A5E;
+static constexpr uint32_t ZSTD_SEEKABLE_MAGIC = 0x8F92EAB1;
+//! Number_Of_Frames(4) + Seek_Table_Descriptor(1) + Seekable_Magic_Number(4).
+static constexpr idx_t ZSTD_SEEK_TABLE_FOOTER_SIZE = 9;
+//! Skippable frame magic(4) + Frame_Size(4).
+static constexpr idx_t ZSTD_SKIPPABLE_HEADER_SIZE = 8;
+
+static uint32_t LoadLE16(const uint8_t *p) {
+	return uint32_t(p[0]) | (uint32_t(p[1]) << 8);
+}
+
+static uint32_t LoadLE32(const uint8_t *p) {
+	return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+//! Bytes read at a time while walking a BGZF block table. A BGZF member is at most 64KB, so a chunk
+//! holds the headers of a dozen or more of them.
+static constexpr idx_t BGZF_SCAN_CHUNK_SIZE = 1048576; // 1MB
+
+//! Reads a file front to back in BGZF_SCAN_CHUNK_SIZE chunks, so that walking its block table costs
+//! one read per chunk rather than several small ones per block.
+class ZeekChunkedReader {
+public:
+	ZeekChunkedReader(FileHandle &handle, idx_t file_size) : handle(handle), file_size(file_size) {
+	}
+
+	//! Bytes [offset, offset + len) of the file, valid until the next call, or null if they run past its
+	//! end. A range outside the current chunk starts a new chunk at `offset`.
+	const uint8_t *Get(idx_t offset, idx_t len) {
+		if (offset + len > file_size) {
+			return nullptr;
+		}
+		if (offset < chunk_offset || offset + len > chunk_offset + chunk.size()) {
+			chunk.resize(MinValue<idx_t>(MaxValue<idx_t>(len, BGZF_SCAN_CHUNK_SIZE), file_size - offset));
+			handle.Read(chunk.data(), chunk.size(), offset);
+			chunk_offset = offset;
+		}
+		return chunk.data() + (offset - chunk_offset);
+	}
+
+private:
+	FileHandle &handle;
+	const idx_t file_size;
+	vector<uint8_t> chunk;
+	idx_t chunk_offset = 0;
+};
+
+//! Parse the BGZF member starting at `offset`. Returns false if the bytes there are not a BGZF member.
+static bool ReadBgzfBlock(ZeekChunkedReader &reader, idx_t offset, ZeekCompressedBlock &block) {
+	const uint8_t *fixed = reader.Get(offset, GZIP_FIXED_HEADER_SIZE);
+	if (!fixed || fixed[0] != 0x1F || fixed[1] != 0x8B || fixed[2] != 8 || (fixed[3] & GZIP_FLAG_EXTRA) == 0) {
+		return false;
+	}
+	const idx_t xlen = LoadLE16(fixed + 10);
+	const uint8_t *header = reader.Get(offset, GZIP_FIXED_HEADER_SIZE + xlen);
+	if (!header) {
+		return false;
+	}
+	const uint8_t *extra = header + GZIP_FIXED_HEADER_SIZE;
+
+	// Look for the 'BC' subfield holding the total member size minus one.
+	idx_t block_size = 0;
+	for (idx_t pos = 0; pos + 4 <= xlen;) {
+		const idx_t slen = LoadLE16(&extra[pos + 2]);
+		if (extra[pos] == 'B' && extra[pos + 1] == 'C' && slen == 2 && pos + 6 <= xlen) {
+			block_size = LoadLE16(&extra[pos + 4]) + 1;
+			break;
+		}
+		pos += 4 + slen;
+	}
+	if (block_size < GZIP_FIXED_HEADER_SIZE + xlen + GZIP_TRAILER_SIZE) {
+		return false;
+	}
+
+	// ISIZE (the decompressed size) is the last field of the member trailer.
+	const uint8_t *member = reader.Get(offset, block_size);
+	if (!member) {
+		return false;
+	}
+	block.offset = offset;
+	block.compressed_size = block_size;
+	block.decompressed_size = LoadLE32(member + block_size - 4);
+	return true;
+}
+
+static bool DetectBgzf(FileHandle &handle, idx_t file_size, vector<ZeekCompressedBlock> &blocks) {
+	ZeekChunkedReader reader(handle, file_size);
+	idx_t offset = 0;
+	while (offset < file_size) {
+		ZeekCompressedBlock block;
+		if (!ReadBgzfBlock(reader, offset, block)) {
+			return false;
+		}
+		blocks.push_back(block);
+		offset += block.compressed_size;
+	}
+	return !blocks.empty();
+}
+
+static bool DetectSeekableZstd(FileHandle &handle, idx_t file_size, vector<ZeekCompressedBlock> &blocks) {
+#ifndef ZEEK_HAVE_ZSTD
+	return false;
+#else
+	if (file_size < ZSTD_SKIPPABLE_HEADER_SIZE + ZSTD_SEEK_TABLE_FOOTER_SIZE) {
+		return false;
+	}
+	uint8_t footer[ZSTD_SEEK_TABLE_FOOTER_SIZE];
+	handle.Read(footer, ZSTD_SEEK_TABLE_FOOTER_SIZE, file_size - ZSTD_SEEK_TABLE_FOOTER_SIZE);
+	if (LoadLE32(footer + 5) != ZSTD_SEEKABLE_MAGIC) {
+		return false;
+	}
+	const idx_t frame_count = LoadLE32(footer);
+	const uint8_t descriptor = footer[4];
+	if (descriptor & 0x7C) {
+		// Reserved bits must be zero.
+		return false;
+	}
+	const idx_t entry_size = (descriptor & 0x80) ? 12 : 8;
+	if (frame_count > file_size / entry_size) {
+		return false;
+	}
+	const idx_t table_size = frame_count * entry_size;
+	const idx_t seek_table_frame_size = ZSTD_SKIPPABLE_HEADER_SIZE + table_size + ZSTD_SEEK_TABLE_FOOTER_SIZE;
+	if (seek_table_frame_size > file_size) {
+		return false;
+	}
+	const idx_t seek_table_offset = file_size - seek_table_frame_size;
+	vector<uint8_t> table(ZSTD_SKIPPABLE_HEADER_SIZE + table_size);
+	handle.Read(table.data(), table.size(), seek_table_offset);
+	if (LoadLE32(&table[0]) != ZSTD_SEEK_TABLE_SKIPPABLE_MAGIC ||
+	    LoadLE32(&table[4]) != table_size + ZSTD_SEEK_TABLE_FOOTER_SIZE) {
+		return false;
+	}
+
+	// Frames are laid out back to back from the start of the file, ending at the seek table.
+	idx_t offset = 0;
+	for (idx_t i = 0; i < frame_count; i++) {
+		const uint8_t *entry = &table[ZSTD_SKIPPABLE_HEADER_SIZE + i * entry_size];
+		ZeekCompressedBlock block;
+		block.offset = offset;
+		block.compressed_size = LoadLE32(entry);
+		block.decompressed_size = LoadLE32(entry + 4);
+		blocks.push_back(block);
+		offset += block.compressed_size;
+	}
+	return !blocks.empty() && offset == seek_table_offset;
+#endif
+}
+
+ZeekBlockFormat ZeekBlockCodec::DetectBlocks(FileHandle &handle, vector<ZeekCompressedBlock> &blocks) {
+	const idx_t file_size = handle.GetFileSize();
+	blocks.clear();
+	if (DetectBgzf(handle, file_size, blocks)) {
+		return ZeekBlockFormat::BGZF;
+	}
+	blocks.clear();
+	if (DetectSeekableZstd(handle, file_size, blocks)) {
+		return ZeekBlockFormat::SEEKABLE_ZSTD;
+	}
+	blocks.clear();
+	return ZeekBlockFormat::NONE;
+}
+
+idx_t ZeekBlockCodec::DecompressBlock(ZeekBlockFormat format, const ZeekCompressedBlock &block, const char *data,
+                                      vector<char> &out) {
+	switch (format) {
+	case ZeekBlockFormat::BGZF: {
+		const idx_t payload_offset = GZIP_FIXED_HEADER_SIZE + LoadLE16(reinterpret_cast<const uint8_t *>(data) + 10);
+#ifdef ZEEK_HAVE_MINIZ
+		// Inflate the member's raw deflate payload (between its header and trailer) straight into `out`.
+		if (out.size() < block.decompressed_size) {
+			out.resize(block.decompressed_size);
+		}
+		duckdb_miniz::mz_stream stream;
+		std::memset(&stream, 0, sizeof(stream));
+		if (duckdb_miniz::mz_inflateInit2(&stream, -MZ_DEFAULT_WINDOW_BITS) != duckdb_miniz::MZ_OK) {
+			throw IOException("read_zeek: failed to initialize the BGZF decoder");
+		}
+		stream.next_in = reinterpret_cast<const unsigned char *>(data) + payload_offset;
+		stream.avail_in = UnsafeNumericCast<unsigned int>(block.compressed_size - payload_offset - GZIP_TRAILER_SIZE);
+		stream.next_out = reinterpret_cast<unsigned char *>(out.data());
+		stream.avail_out = UnsafeNumericCast<unsigned int>(block.decompressed_size);
+		const int status = duckdb_miniz::mz_inflate(&stream, duckdb_miniz::MZ_FINISH);
+		const idx_t decompressed = stream.total_out;
+		duckdb_miniz::mz_inflateEnd(&stream);
+		if (status != duckdb_miniz::MZ_STREAM_END || decompressed != block.decompressed_size) {
+			throw IOException("read_zeek: failed to decompress BGZF block at offset %llu", block.offset);
+		}
+		return decompressed;
+#else
+		// DuckDB's in-memory gzip decoder rejects the FEXTRA field, so re-frame the member with a
+		// minimal header around its unchanged deflate payload and trailer.
+		string member;
+		member.reserve(MINIMAL_GZIP_HEADER_SIZE + block.compressed_size - payload_offset);
+		member.append(MINIMAL_GZIP_HEADER, MINIMAL_GZIP_HEADER_SIZE);
+		member.append(data + payload_offset, block.compressed_size - payload_offset);
+		auto decompressed = GZipFileSystem::UncompressGZIPString(member);
+		if (out.size() < decompressed.size()) {
+			out.resize(decompressed.size());
+		}
+		std::memcpy(out.data(), decompressed.data(), decompressed.size());
+		return decompressed.size();
+#endif
+	}
+	case ZeekBlockFormat::SEEKABLE_ZSTD: {
+#ifdef ZEEK_HAVE_ZSTD
+		if (out.size() < block.decompressed_size) {
+			out.resize(block.decompressed_size);
+		}
+		auto result = duckdb_zstd::ZSTD_decompress(out.data(), block.decompressed_size, data, block.compressed_size);
+		if (duckdb_zstd::ZSTD_isError(result)) {
+			throw IOException("read_zeek: failed to decompress seekable zstd frame: %s",
+			                  duckdb_zstd::ZSTD_getErrorName(result));
+		}
+		return result;
+#else
+		throw InternalException("read_zeek: seekable zstd support is not compiled in");
+#endif
+	}
+	default:
+		throw InternalException("read_zeek: DecompressBlock called for a non-block-compressed file");
+	}
+}
+
+} // namespace duckdb
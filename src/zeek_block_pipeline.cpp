@@ -0,0 +1,129 @@
+#include "zeek_block_pipeline.hpp"
+
+namespace duckdb {
+
+//! Reads blocks ahead for one pipeline, until the ring is full.
+class ZeekBlockReadTask : public Task {
+public:
+	explicit ZeekBlockReadTask(shared_ptr<ZeekBlockPipeline::State> state_p) : state(std::move(state_p)) {
+	}
+
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		state->ReadAhead();
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+
+	string TaskType() const override {
+		return "ZeekBlockReadTask";
+	}
+
+private:
+	shared_ptr<ZeekBlockPipeline::State> state;
+};
+
+ZeekBlockPipeline::ZeekBlockPipeline(TaskScheduler &scheduler_p, FileHandle &handle, idx_t block_size,
+                                     idx_t block_count)
+    : scheduler(scheduler_p), token(scheduler_p.CreateProducer()), state(make_shared_ptr<State>()) {
+	state->handle = &handle;
+	state->block_size = block_size;
+	state->free_blocks.resize(block_count);
+	for (auto &block : state->free_blocks) {
+		block.resize(block_size);
+	}
+	std::lock_guard<std::mutex> guard(state->lock);
+	ScheduleReadAhead();
+}
+
+ZeekBlockPipeline::~ZeekBlockPipeline() {
+	std::unique_lock<std::mutex> guard(state->lock);
+	state->read_done.wait(guard, [&] { return !state->reading; });
+	state->handle = nullptr;
+}
+
+void ZeekBlockPipeline::ScheduleReadAhead() {
+	if (state->task_pending || state->reading || state->done || state->free_blocks.empty()) {
+		return;
+	}
+	state->task_pending = true;
+	scheduler.ScheduleTask(*token, make_shared_ptr<ZeekBlockReadTask>(state));
+}
+
+void ZeekBlockPipeline::State::ReadAhead() {
+	std::unique_lock<std::mutex> guard(lock);
+	task_pending = false;
+	while (handle && !reading && !done && !free_blocks.empty()) {
+		reading = true;
+		auto block = std::move(free_blocks.back());
+		free_blocks.pop_back();
+		guard.unlock();
+
+		idx_t bytes_read = 0;
+		ErrorData read_error;
+		try {
+			bytes_read = static_cast<idx_t>(handle->Read(block.data(), block.size()));
+		} catch (const std::exception &ex) {
+			read_error = ErrorData(ex);
+		}
+
+		guard.lock();
+		reading = false;
+		if (read_error.HasError()) {
+			error = std::move(read_error);
+			has_error = true;
+			done = true;
+		} else if (bytes_read == 0) {
+			done = true;
+		} else {
+			filled_blocks.push_back({std::move(block), bytes_read});
+		}
+		read_done.notify_all();
+	}
+}
+
+idx_t ZeekBlockPipeline::NextBlock(vector<char> &buffer) {
+	std::unique_lock<std::mutex> guard(state->lock);
+	while (state->filled_blocks.empty()) {
+		if (state->done) {
+			if (state->has_error) {
+				state->error.Throw();
+			}
+			return 0;
+		}
+		if (state->reading) {
+			// A task is reading the next block.
+			state->read_done.wait(guard);
+			continue;
+		}
+		// No task is reading: read the next block on this thread, and have a task read on from there.
+		state->reading = true;
+		guard.unlock();
+		buffer.resize(state->block_size);
+		idx_t bytes_read;
+		try {
+			bytes_read = static_cast<idx_t>(state->handle->Read(buffer.data(), buffer.size()));
+		} catch (...) {
+			guard.lock();
+			state->reading = false;
+			state->done = true;
+			state->read_done.notify_all();
+			throw;
+		}
+		guard.lock();
+		state->reading = false;
+		state->done = bytes_read == 0;
+		state->read_done.notify_all();
+		ScheduleReadAhead();
+		return bytes_read;
+	}
+
+	auto block = std::move(state->filled_blocks.front());
+	state->filled_blocks.pop_front();
+	std::swap(buffer, block.data);
+	// Recycle the consumer's previous buffer as a free slot for the read-ahead.
+	block.data.resize(state->block_size);
+	state->free_blocks.push_back(std::move(block.data));
+	ScheduleReadAhead();
+	return block.size;
+}
+
+} // namespace duckdb
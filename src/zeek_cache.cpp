@@ -0,0 +1,496 @@
+#include "zeek_cache.hpp"
+#include "zeek_header_cache.hpp"
+#include "zeek_index.hpp"
+#include "zeek_reader.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/parser/parser.hpp"
+#include "duckdb/parser/statement/select_statement.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace duckdb {
+
+//! Part of every cache key; bumped whenever the layout of the cached files changes, which retires the
+//! entries written before.
+static constexpr idx_t CACHE_FORMAT_VERSION = 1;
+//! Column of a cached file holding the path of the log it was parsed from.
+static constexpr const char *SOURCE_COLUMN = "__zeek_source";
+
+//! The options of a read_zeek call with `cache_dir`.
+struct ZeekCacheOptions {
+	string cache_dir;
+	bool filename = false;
+	bool replace_periods = true;
+	bool use_inet = true;
+	bool union_by_name = false;
+	bool ignore_file_errors = false;
+};
+
+static bool GetBoolParameter(const named_parameter_map_t &parameters, const string &name, bool default_value) {
+	auto entry = parameters.find(name);
+	if (entry == parameters.end() || entry->second.IsNull()) {
+		return default_value;
+	}
+	return entry->second.GetValue<bool>();
+}
+
+//! Path of the cache entry of the log at `path`, as it was when `header` was parsed from it. Columns
+//! are cached as VARCHAR where `inet` would make them INET, so only replace_periods (which names them)
+//! is part of the key.
+static string EntryPath(FileSystem &fs, const string &cache_dir, bool replace_periods, const string &path,
+                        const ZeekHeader &header) {
+	auto key = StringUtil::Format("%llu:%s:%llu:%lld:%d", static_cast<unsigned long long>(CACHE_FORMAT_VERSION),
+	                              path, static_cast<unsigned long long>(header.source_size),
+	                              static_cast<long long>(header.source_mtime), replace_periods ? 1 : 0);
+	auto name = StringUtil::Format("zeek_%016llx", static_cast<unsigned long long>(Hash(key.c_str(), key.size())));
+	return fs.JoinPath(cache_dir, name + ".parquet");
+}
+
+//! A log matched by a read_zeek call with `cache_dir`, and its cache entry.
+struct ZeekCachedLog {
+	string path;
+	//! The log's header; null if `error` is set.
+	shared_ptr<const ZeekHeader> header;
+	string entry_path;
+	//! True if the entry exists. Entries are moved into place once complete, so it is then readable.
+	bool cached = false;
+	ErrorData error;
+};
+
+//! Number of logs whose entries one task looks up.
+static constexpr idx_t LOOKUP_TASK_LOG_COUNT = 8;
+
+//! Looks up the entries of logs [start, end). The size and modification time in an entry's key come
+//! from the header cache, which stats each log anyway.
+class ZeekCacheLookupTask : public BaseExecutorTask {
+public:
+	ZeekCacheLookupTask(TaskExecutor &executor, ClientContext &context, const ZeekCacheOptions &options,
+	                    vector<ZeekCachedLog> &logs, idx_t start, idx_t end)
+	    : BaseExecutorTask(executor), context(context), options(options), logs(logs), start(start), end(end) {
+	}
+
+	void ExecuteTask() override {
+		auto &fs = FileSystem::GetFileSystem(context);
+		for (idx_t i = start; i < end; i++) {
+			auto &log = logs[i];
+			try {
+				log.header = ZeekHeaderCache::GetHeader(context, log.path);
+				log.entry_path = EntryPath(fs, options.cache_dir, options.replace_periods, log.path, *log.header);
+				log.cached = fs.FileExists(log.entry_path);
+			} catch (std::exception &ex) {
+				log.header = nullptr;
+				log.error = ErrorData(ex);
+			}
+		}
+	}
+
+	string TaskType() const override {
+		return "ZeekCacheLookupTask";
+	}
+
+private:
+	ClientContext &context;
+	const ZeekCacheOptions &options;
+	vector<ZeekCachedLog> &logs;
+	const idx_t start;
+	const idx_t end;
+};
+
+void ZeekCache::BindWriteThrough(ClientContext &context, const string &cache_dir, bool replace_periods,
+                                 ZeekScanBindData &bind_data) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	if (!fs.DirectoryExists(cache_dir)) {
+		fs.CreateDirectory(cache_dir);
+	}
+	// Strict mode parsed only the first file's header; the others are needed for their keys.
+	vector<idx_t> unparsed;
+	vector<string> unparsed_paths;
+	for (idx_t file_idx = 0; file_idx < bind_data.file_paths.size(); file_idx++) {
+		if (!bind_data.file_headers[file_idx]) {
+			unparsed.push_back(file_idx);
+			unparsed_paths.push_back(bind_data.file_paths[file_idx]);
+		}
+	}
+	if (!unparsed.empty()) {
+		vector<shared_ptr<const ZeekHeader>> headers;
+		vector<ErrorData> errors;
+		ZeekHeaderCache::GetHeaders(context, unparsed_paths, headers, errors);
+		for (idx_t i = 0; i < unparsed.size(); i++) {
+			// A log whose header can't be read isn't written; the scan reports (or skips) its error.
+			bind_data.file_headers[unparsed[i]] = headers[i];
+		}
+	}
+	bind_data.parquet_paths.resize(bind_data.file_paths.size());
+	for (idx_t file_idx = 0; file_idx < bind_data.file_paths.size(); file_idx++) {
+		auto &header = bind_data.file_headers[file_idx];
+		if (header) {
+			bind_data.parquet_paths[file_idx] =
+			    EntryPath(fs, cache_dir, replace_periods, bind_data.file_paths[file_idx], *header);
+		}
+	}
+	bind_data.parquet_source_column = SOURCE_COLUMN;
+}
+
+//! The read_zeek parameters a cached scan supports. The others either change how files are read,
+//! which the cached copies have settled, or which parts of them are (since, sample, indexes).
+static const char *const CACHE_PARAMETERS[] = {"cache_dir", "filename", "replace_periods", "inet", "union_by_name",
+                                               "ignore_file_errors"};
+
+unique_ptr<TableRef> ZeekCache::BindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	auto &parameters = input.named_parameters;
+	auto cache_dir_param = parameters.find("cache_dir");
+	if (cache_dir_param == parameters.end() || cache_dir_param->second.IsNull()) {
+		return nullptr;
+	}
+	for (auto &parameter : parameters) {
+		bool supported = false;
+		for (auto name : CACHE_PARAMETERS) {
+			supported = supported || StringUtil::CIEquals(parameter.first, name);
+		}
+		if (!supported && !parameter.second.IsNull()) {
+			throw InvalidInputException("read_zeek: cache_dir can't be combined with %s", parameter.first);
+		}
+	}
+	ZeekCacheOptions options;
+	options.cache_dir = cache_dir_param->second.GetValue<string>();
+	options.filename = GetBoolParameter(parameters, "filename", false);
+	options.replace_periods = GetBoolParameter(parameters, "replace_periods", true);
+	options.use_inet = GetBoolParameter(parameters, "inet", true);
+	options.union_by_name = GetBoolParameter(parameters, "union_by_name", false);
+	options.ignore_file_errors = GetBoolParameter(parameters, "ignore_file_errors", false);
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	const vector<string> file_paths = ZeekScan::GlobFiles(fs, input.inputs[0]);
+	if (!fs.DirectoryExists(options.cache_dir)) {
+		fs.CreateDirectory(options.cache_dir);
+	}
+
+	vector<ZeekCachedLog> logs(file_paths.size());
+	for (idx_t i = 0; i < file_paths.size(); i++) {
+		logs[i].path = file_paths[i];
+	}
+	{
+		// Each task writes only its own logs' slots, so the results don't depend on scheduling.
+		TaskExecutor executor(context);
+		for (idx_t start = 0; start < logs.size(); start += LOOKUP_TASK_LOG_COUNT) {
+			const idx_t end = MinValue<idx_t>(start + LOOKUP_TASK_LOG_COUNT, logs.size());
+			executor.ScheduleTask(make_uniq<ZeekCacheLookupTask>(executor, context, options, logs, start, end));
+		}
+		executor.WorkOnTasks();
+	}
+	bool any_cached = false;
+	for (auto &log : logs) {
+		any_cached = any_cached || log.cached;
+	}
+	if (!any_cached) {
+		// read_zeek reads every log, writing their entries as it goes.
+		return nullptr;
+	}
+
+	// Collect the output columns like bind does: the first file's columns, or in union mode each
+	// column in the order of its first appearance.
+	vector<const ZeekCachedLog *> valid_logs;
+	vector<string> column_names;
+	vector<string> column_types;
+	std::unordered_map<string, idx_t> column_index;
+	string first_path;
+	for (auto &log : logs) {
+		if (log.error.HasError()) {
+			if (!options.ignore_file_errors) {
+				log.error.Throw();
+			}
+			continue;
+		}
+		const string &path = log.path;
+		const ZeekHeader &header = *log.header;
+		vector<string> names = header.fields;
+		if (options.replace_periods) {
+			for (auto &name : names) {
+				std::replace(name.begin(), name.end(), '.', '_');
+			}
+		}
+		if (valid_logs.empty()) {
+			first_path = path;
+			column_names = names;
+			column_types = header.types;
+			for (idx_t i = 0; i < names.size(); i++) {
+				column_index[names[i]] = i;
+			}
+		} else if (!options.union_by_name) {
+			if (names != column_names || header.types != column_types) {
+				throw InvalidInputException(
+				    "read_zeek: file '%s' has a different schema than '%s' (the first file in the glob)", path,
+				    first_path);
+			}
+		} else {
+			for (idx_t i = 0; i < names.size(); i++) {
+				auto entry = column_index.find(names[i]);
+				if (entry == column_index.end()) {
+					column_index[names[i]] = column_names.size();
+					column_names.push_back(names[i]);
+					column_types.push_back(header.types[i]);
+				} else if (column_types[entry->second] != header.types[i]) {
+					throw InvalidInputException("read_zeek: field '%s' has type '%s' in '%s' but type '%s' in '%s'",
+					                            header.fields[i], column_types[entry->second], first_path,
+					                            header.types[i], path);
+				}
+			}
+		}
+		valid_logs.push_back(&log);
+	}
+
+	// Addresses are cached as VARCHAR, and cast to INET here when asked for.
+	vector<string> select_list;
+	vector<string> cached_select_list;
+	for (idx_t i = 0; i < column_names.size(); i++) {
+		auto name = KeywordHelper::WriteOptionallyQuoted(column_names[i]);
+		select_list.push_back(name);
+		auto type = ZeekReader::ZeekTypeToDuckDBType(column_types[i], options.use_inet, &context);
+		if (type != ZeekReader::ZeekTypeToDuckDBType(column_types[i], false)) {
+			cached_select_list.push_back(StringUtil::Format("CAST(%s AS %s) AS %s", name, type.ToString(), name));
+		} else {
+			cached_select_list.push_back(name);
+		}
+	}
+	if (options.filename) {
+		select_list.push_back("filename");
+		cached_select_list.push_back(StringUtil::Format("%s AS filename", SOURCE_COLUMN));
+	}
+
+	// Read each run of consecutive cached logs with read_parquet, and each run of the others with a
+	// read_zeek that writes their entries. In union mode, a run lacking some of the columns gets NULLs
+	// for them from UNION ALL BY NAME.
+	const string bool_options =
+	    StringUtil::Format("replace_periods=%s, inet=%s, union_by_name=%s, ignore_file_errors=%s",
+	                       options.replace_periods ? "true" : "false", options.use_inet ? "true" : "false",
+	                       options.union_by_name ? "true" : "false", options.ignore_file_errors ? "true" : "false");
+	vector<string> branches;
+	for (idx_t start = 0; start < valid_logs.size();) {
+		const bool cached = valid_logs[start]->cached;
+		vector<string> quoted_paths;
+		idx_t end = start;
+		for (; end < valid_logs.size() && valid_logs[end]->cached == cached; end++) {
+			auto &log = *valid_logs[end];
+			quoted_paths.push_back(KeywordHelper::WriteQuoted(cached ? log.entry_path : log.path, '\''));
+		}
+		const string paths = "[" + StringUtil::Join(quoted_paths, ", ") + "]";
+		if (cached) {
+			// Only the columns of the run's own logs are selected.
+			std::unordered_set<string> run_columns;
+			for (idx_t i = start; i < end; i++) {
+				for (auto &field : valid_logs[i]->header->fields) {
+					string name = field;
+					if (options.replace_periods) {
+						std::replace(name.begin(), name.end(), '.', '_');
+					}
+					run_columns.insert(name);
+				}
+			}
+			vector<string> run_select_list;
+			for (idx_t i = 0; i < column_names.size(); i++) {
+				if (run_columns.count(column_names[i])) {
+					run_select_list.push_back(cached_select_list[i]);
+				}
+			}
+			if (options.filename) {
+				run_select_list.push_back(cached_select_list.back());
+			}
+			branches.push_back(StringUtil::Format("SELECT %s FROM read_parquet(%s, union_by_name=%s)",
+			                                      StringUtil::Join(run_select_list, ", "), paths,
+			                                      options.union_by_name ? "true" : "false"));
+		} else {
+			branches.push_back(StringUtil::Format(
+			    "SELECT * FROM read_zeek(%s, cache_dir=%s, filename=%s, %s)", paths,
+			    KeywordHelper::WriteQuoted(options.cache_dir, '\''), options.filename ? "true" : "false",
+			    bool_options));
+		}
+		start = end;
+	}
+	string query;
+	if (branches.size() == 1) {
+		query = branches[0];
+	} else {
+		query = StringUtil::Format("SELECT %s FROM (%s)", StringUtil::Join(select_list, ", "),
+		                           StringUtil::Join(branches, " UNION ALL BY NAME "));
+	}
+
+	Parser parser(context.GetParserOptions());
+	parser.ParseQuery(query);
+	auto select = unique_ptr_cast<SQLStatement, SelectStatement>(std::move(parser.statements[0]));
+	return make_uniq<SubqueryRef>(std::move(select));
+}
+
+//! Codecs zeek_convert accepts, as spelled in COPY's COMPRESSION option.
+static const char *const CONVERT_COMPRESSIONS[] = {"uncompressed", "snappy", "gzip", "zstd", "lz4", "brotli"};
+
+//! zeek_convert runs read_zeek's scan in union mode, with a column for each type of a field, writing
+//! each file's rows to its output as the scan reads them. Its own rows describe the files written.
+struct ZeekConvertBindData : public TableFunctionData {
+	unique_ptr<ZeekScanBindData> scan;
+};
+
+struct ZeekConvertGlobalState : public GlobalTableFunctionState {
+	unique_ptr<ZeekScanGlobalState> scan;
+
+	idx_t MaxThreads() const override {
+		return scan->MaxThreads();
+	}
+};
+
+struct ZeekConvertLocalState : public LocalTableFunctionState {
+	unique_ptr<ZeekScanLocalState> scan;
+	//! The scan's output, which has no columns.
+	DataChunk scan_chunk;
+};
+
+//! `conn.00:00:00-01:00:00.log.gz` is converted to `conn.00:00:00-01:00:00.parquet`.
+static string ConvertOutputName(FileSystem &fs, const string &path) {
+	string name = fs.ExtractName(path);
+	for (auto extension : {".gz", ".zst", ".log"}) {
+		if (StringUtil::EndsWith(name, extension) && name.size() > strlen(extension)) {
+			name = name.substr(0, name.size() - strlen(extension));
+		}
+	}
+	return name + ".parquet";
+}
+
+static unique_ptr<FunctionData> ZeekConvertBind(ClientContext &context, TableFunctionBindInput &input,
+                                                vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<ZeekConvertBindData>();
+	const string output_dir = input.inputs[1].GetValue<string>();
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	auto compression = string("zstd");
+	auto compression_param = input.named_parameters.find("compression");
+	if (compression_param != input.named_parameters.end() && !compression_param->second.IsNull()) {
+		compression = StringUtil::Lower(compression_param->second.GetValue<string>());
+		bool known = false;
+		for (auto codec : CONVERT_COMPRESSIONS) {
+			known = known || compression == codec;
+		}
+		if (!known) {
+			throw InvalidInputException("zeek_convert: unknown compression '%s'", compression);
+		}
+	}
+
+	// Name the outputs first, so that a collision is reported before any header is read.
+	vector<Value> file_values;
+	vector<string> output_paths;
+	std::unordered_map<string, string> output_files;
+	for (auto &path : ZeekScan::GlobFiles(fs, input.inputs[0])) {
+		auto output_path = fs.JoinPath(output_dir, ConvertOutputName(fs, path));
+		auto entry = output_files.find(output_path);
+		if (entry != output_files.end()) {
+			throw InvalidInputException("zeek_convert: '%s' and '%s' would both be converted to '%s'",
+			                            entry->second, path, output_path);
+		}
+		output_files[output_path] = path;
+		file_values.push_back(Value(path));
+		output_paths.push_back(output_path);
+	}
+
+	// Each file keeps its own fields and types: in union mode each file's rows fill only the columns
+	// of its own fields, and with separate types a field's types don't conflict.
+	named_parameter_map_t scan_parameters;
+	scan_parameters["union_by_name"] = Value::BOOLEAN(true);
+	scan_parameters["inet"] = Value::BOOLEAN(false);
+	scan_parameters["replace_periods"] =
+	    Value::BOOLEAN(GetBoolParameter(input.named_parameters, "replace_periods", true));
+	scan_parameters["ignore_file_errors"] =
+	    Value::BOOLEAN(GetBoolParameter(input.named_parameters, "ignore_file_errors", false));
+	vector<LogicalType> scan_types;
+	vector<string> scan_names;
+	result->scan = ZeekScan::Bind(context, Value::LIST(LogicalType::VARCHAR, std::move(file_values)), scan_parameters,
+	                              true, scan_types, scan_names);
+	auto &scan = *result->scan;
+	// The scan's files are the sorted paths, as GlobFiles returned them.
+	scan.parquet_paths = std::move(output_paths);
+	scan.parquet_compression = compression;
+
+	if (!fs.DirectoryExists(output_dir)) {
+		fs.CreateDirectory(output_dir);
+	}
+
+	names.push_back("filename");
+	return_types.push_back(LogicalType::VARCHAR);
+	names.push_back("output");
+	return_types.push_back(LogicalType::VARCHAR);
+	names.push_back("rows");
+	return_types.push_back(LogicalType::UBIGINT);
+	names.push_back("min_ts");
+	return_types.push_back(LogicalType::TIMESTAMP_TZ);
+	names.push_back("max_ts");
+	return_types.push_back(LogicalType::TIMESTAMP_TZ);
+	names.push_back("bytes");
+	return_types.push_back(LogicalType::UBIGINT);
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> ZeekConvertInitGlobal(ClientContext &context,
+                                                                  TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<ZeekConvertBindData>();
+	auto result = make_uniq<ZeekConvertGlobalState>();
+	result->scan = ZeekScan::InitGlobal(context, *bind_data.scan, vector<column_t>(), nullptr);
+	return std::move(result);
+}
+
+static unique_ptr<LocalTableFunctionState> ZeekConvertInitLocal(ExecutionContext &context,
+                                                                TableFunctionInitInput &input,
+                                                                GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<ZeekConvertBindData>();
+	auto &gstate = global_state->Cast<ZeekConvertGlobalState>();
+	auto result = make_uniq<ZeekConvertLocalState>();
+	result->scan = ZeekScan::InitLocal(context, *bind_data.scan, *gstate.scan);
+	result->scan_chunk.InitializeEmpty(vector<LogicalType>());
+	return std::move(result);
+}
+
+//! Emit a row for each file that was written, scanning on until one is. The threads scan the units of
+//! the files (whole files, or the ranges of split ones) like read_zeek does; the thread that ends a
+//! file's last unit usually emits its row.
+static void ZeekConvertExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<ZeekConvertBindData>();
+	auto &gstate = data.global_state->Cast<ZeekConvertGlobalState>();
+	auto &lstate = data.local_state->Cast<ZeekConvertLocalState>();
+	auto &scan = *bind_data.scan;
+	auto &writer = *gstate.scan->parquet_writer;
+	idx_t count = 0;
+	while (count < STANDARD_VECTOR_SIZE) {
+		ZeekWrittenParquet written;
+		if (writer.NextWritten(written)) {
+			output.SetValue(0, count, Value(scan.file_paths[written.file_idx]));
+			output.SetValue(1, count, Value(scan.parquet_paths[written.file_idx]));
+			output.SetValue(2, count, Value::UBIGINT(written.rows));
+			output.SetValue(3, count, written.min_ts);
+			output.SetValue(4, count, written.max_ts);
+			output.SetValue(5, count, Value::UBIGINT(written.bytes));
+			count++;
+			continue;
+		}
+		if (count > 0 || lstate.scan->finished) {
+			break;
+		}
+		lstate.scan_chunk.Reset();
+		ZeekScan::Scan(context, scan, *gstate.scan, *lstate.scan, lstate.scan_chunk);
+	}
+	output.SetCardinality(count);
+}
+
+TableFunction GetZeekConvertFunction() {
+	TableFunction func("zeek_convert", {LogicalType::VARCHAR, LogicalType::VARCHAR}, ZeekConvertExecute,
+	                   ZeekConvertBind, ZeekConvertInitGlobal, ZeekConvertInitLocal);
+	func.named_parameters["replace_periods"] = LogicalType::BOOLEAN;
+	func.named_parameters["compression"] = LogicalType::VARCHAR;
+	func.named_parameters["ignore_file_errors"] = LogicalType::BOOLEAN;
+	return func;
+}
+
+} // namespace duckdb
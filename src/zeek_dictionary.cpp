@@ -0,0 +1,73 @@
+#include "zeek_dictionary.hpp"
+
+#include <atomic>
+
+namespace duckdb {
+
+//! Source of dictionary ids, which tell operators (e.g. hash aggregates) that chunks share a dictionary.
+static std::atomic<idx_t> next_dictionary_id {0};
+
+ZeekColumnDictionary::ZeekColumnDictionary() : sel(STANDARD_VECTOR_SIZE), batch_entries(STANDARD_VECTOR_SIZE) {
+}
+
+sel_t ZeekColumnDictionary::Lookup(const char *ptr, idx_t len) {
+	string_t value(ptr, UnsafeNumericCast<uint32_t>(len));
+	auto it = lookup.find(value);
+	if (it != lookup.end()) {
+		return it->second;
+	}
+	auto entry = UnsafeNumericCast<sel_t>(entries.size());
+	auto stored = heap.AddString(value);
+	entries.push_back(stored);
+	lookup.emplace(stored, entry);
+	return entry;
+}
+
+sel_t ZeekColumnDictionary::NullEntry() {
+	if (null_entry == DConstants::INVALID_INDEX) {
+		null_entry = entries.size();
+		entries.push_back(string_t());
+	}
+	return UnsafeNumericCast<sel_t>(null_entry);
+}
+
+bool ZeekColumnDictionary::EvaluateFilter(const ZeekColumnFilter &filter, sel_t entry) {
+	if (entry >= filter_results.size()) {
+		filter_results.resize(entries.size(), 0);
+	}
+	auto &result = filter_results[entry];
+	if (result == 0) {
+		bool passes;
+		if (entry == null_entry) {
+			passes = filter.EvaluateNull();
+		} else {
+			auto &value = entries[entry];
+			passes = filter.Evaluate({value.GetData(), value.GetSize()});
+		}
+		result = passes ? 2 : 1;
+	}
+	return result == 2;
+}
+
+void ZeekColumnDictionary::Emit(Vector &vec) {
+	if (!dictionary || dictionary->size.GetIndex() != entries.size()) {
+		// New entries since the last chunk: vectors already emitted keep referencing the old entries.
+		dictionary = make_buffer<VectorChildBuffer>(Vector(LogicalType::VARCHAR, MaxValue<idx_t>(entries.size(), 1)));
+		auto &entry_vec = dictionary->data;
+		auto data = FlatVector::GetData<string_t>(entry_vec);
+		for (idx_t i = 0; i < entries.size(); i++) {
+			if (i == null_entry) {
+				FlatVector::SetNull(entry_vec, i, true);
+			} else {
+				data[i] = StringVector::AddString(entry_vec, entries[i]);
+			}
+		}
+		dictionary->size = entries.size();
+		dictionary->id = "zeek_" + to_string(next_dictionary_id++);
+	}
+	vec.Dictionary(dictionary, sel);
+	// The emitted vector holds on to this selection; the next chunk gets its own.
+	sel.Initialize(STANDARD_VECTOR_SIZE);
+}
+
+} // namespace duckdb
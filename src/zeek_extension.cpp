@@ -1,13 +1,19 @@
 #define DUCKDB_EXTENSION_MAIN
 
 #include "zeek_extension.hpp"
+#include "zeek_cache.hpp"
+#include "zeek_index.hpp"
 #include "zeek_reader.hpp"
+#include "zeek_scan_stats.hpp"
 #include "duckdb.hpp"
 
 namespace duckdb {
 
 static void LoadInternal(ExtensionLoader &loader) {
 	loader.RegisterFunction(GetZeekScanFunction());
+	loader.RegisterFunction(GetZeekBuildIndexFunction());
+	loader.RegisterFunction(GetZeekScanStatsFunction());
+	loader.RegisterFunction(GetZeekConvertFunction());
 }
 
 void ZeekExtension::Load(ExtensionLoader &loader) {
@@ -0,0 +1,776 @@
+#include "zeek_filter.hpp"
+#include "zeek_inet.hpp"
+#include "zeek_reader.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/common/string_map_set.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/string_heap.hpp"
+#include "duckdb/common/value_operations/value_operations.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/dynamic_filter.hpp"
+#include "duckdb/planner/filter/expression_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+#include "duckdb/planner/filter/optional_filter.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_set>
+
+namespace duckdb {
+
+//! Parse a slice into a DuckDB Value of the given type. Returns a NULL Value of the target type
+//! on parse failure. This is only used for filters without a typed evaluator, and only for types
+//! where CanPushdownFilterOnType returns true.
+static Value SliceToValue(const FieldSlice &field, const LogicalType &type) {
+	string_t s(field.ptr, field.len);
+	switch (type.id()) {
+	case LogicalTypeId::VARCHAR:
+		return Value(string(field.ptr, field.len));
+	case LogicalTypeId::DOUBLE: {
+		double v;
+		if (TryCast::Operation<string_t, double>(s, v)) {
+			return Value::DOUBLE(v);
+		}
+		return Value(type);
+	}
+	case LogicalTypeId::UBIGINT: {
+		uint64_t v;
+		if (TryCast::Operation<string_t, uint64_t>(s, v)) {
+			return Value::UBIGINT(v);
+		}
+		return Value(type);
+	}
+	case LogicalTypeId::BIGINT: {
+		int64_t v;
+		if (TryCast::Operation<string_t, int64_t>(s, v)) {
+			return Value::BIGINT(v);
+		}
+		return Value(type);
+	}
+	case LogicalTypeId::BOOLEAN: {
+		bool b = (field.len == 1 && field.ptr[0] == 'T') || (field.len == 4 && std::memcmp(field.ptr, "true", 4) == 0);
+		return Value::BOOLEAN(b);
+	}
+	case LogicalTypeId::USMALLINT: {
+		uint16_t v;
+		if (TryCast::Operation<string_t, uint16_t>(s, v)) {
+			return Value::USMALLINT(v);
+		}
+		return Value(type);
+	}
+	case LogicalTypeId::TIMESTAMP_TZ: {
+		timestamp_tz_t v;
+		if (ZeekReader::TryParseTime(field.ptr, field.len, v)) {
+			return Value::TIMESTAMPTZ(v);
+		}
+		return Value(type);
+	}
+	case LogicalTypeId::INTERVAL: {
+		interval_t v;
+		if (ZeekReader::TryParseInterval(field.ptr, field.len, v)) {
+			return Value::INTERVAL(v);
+		}
+		return Value(type);
+	}
+	case LogicalTypeId::STRUCT: {
+		ZeekInetAddress address;
+		if (ZeekInet::IsInetType(type) && ZeekInet::Parse(field.ptr, field.len, address)) {
+			return ZeekInet::ToValue(type, address);
+		}
+		return Value(type);
+	}
+	default:
+		// Should never be reached — CanPushdownFilterOnType restricts the types we see here.
+		return Value(type);
+	}
+}
+
+//! Evaluate a filter against a value. `is_null` indicates whether `val` represents a SQL NULL
+//! (Value is not null-tagged otherwise). Returns true if the row passes the filter.
+static bool EvaluateFilter(const TableFilter &filter, const Value &val, bool is_null) {
+	switch (filter.filter_type) {
+	case TableFilterType::IS_NULL:
+		return is_null;
+	case TableFilterType::IS_NOT_NULL:
+		return !is_null;
+	case TableFilterType::CONSTANT_COMPARISON: {
+		if (is_null) {
+			// NULL compared with anything is NULL → row filtered out.
+			return false;
+		}
+		return filter.Cast<ConstantFilter>().Compare(val);
+	}
+	case TableFilterType::IN_FILTER: {
+		if (is_null) {
+			return false;
+		}
+		auto &in_filter = filter.Cast<InFilter>();
+		for (auto &v : in_filter.values) {
+			if (!v.IsNull() && ValueOperations::Equals(v, val)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		auto &conj = filter.Cast<ConjunctionAndFilter>();
+		for (auto &child : conj.child_filters) {
+			if (!EvaluateFilter(*child, val, is_null)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		auto &conj = filter.Cast<ConjunctionOrFilter>();
+		for (auto &child : conj.child_filters) {
+			if (EvaluateFilter(*child, val, is_null)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	case TableFilterType::EXPRESSION_FILTER:
+		// `val` is a NULL of the column type when is_null is set.
+		return filter.Cast<ExpressionFilter>().EvaluateValue(val);
+	case TableFilterType::OPTIONAL_FILTER: {
+		auto &child = filter.Cast<OptionalFilter>().child_filter;
+		return !child || EvaluateFilter(*child, val, is_null);
+	}
+	default:
+		// Unknown filter type — be safe: let the row through, DuckDB will re-evaluate post-scan.
+		return true;
+	}
+}
+
+//! Fallback: parse the field into a Value and evaluate the TableFilter on it.
+class ValueColumnFilter : public ZeekColumnFilter {
+public:
+	ValueColumnFilter(const TableFilter &filter_p, const LogicalType &type_p) : filter(filter_p), type(type_p) {
+		null_result = EvaluateFilter(filter, Value(type), true);
+	}
+
+	bool Evaluate(const FieldSlice &field) const override {
+		Value val = SliceToValue(field, type);
+		return EvaluateFilter(filter, val, val.IsNull());
+	}
+
+private:
+	const TableFilter &filter;
+	LogicalType type;
+};
+
+//! Hash set of the constants of an IN filter.
+template <class T>
+class FilterValueSet {
+public:
+	void Insert(const T &value) {
+		values.insert(value);
+	}
+	bool Contains(const T &value) const {
+		return values.find(value) != values.end();
+	}
+
+private:
+	std::unordered_set<T> values;
+};
+
+template <>
+class FilterValueSet<string_t> {
+public:
+	void Insert(const string_t &value) {
+		values.insert(value);
+	}
+	bool Contains(const string_t &value) const {
+		return values.find(value) != values.end();
+	}
+
+private:
+	string_set_t values;
+};
+
+//! Doubles are keyed by bit pattern, after mapping the values DuckDB compares as equal (every NaN,
+//! and -0.0 / 0.0) to a single representative.
+template <>
+class FilterValueSet<double> {
+public:
+	void Insert(const double &value) {
+		values.insert(Key(value));
+	}
+	bool Contains(const double &value) const {
+		return values.find(Key(value)) != values.end();
+	}
+
+private:
+	static uint64_t Key(double value) {
+		if (std::isnan(value)) {
+			value = std::numeric_limits<double>::quiet_NaN();
+		} else if (value == 0) {
+			value = 0;
+		}
+		uint64_t key;
+		std::memcpy(&key, &value, sizeof(key));
+		return key;
+	}
+
+	std::unordered_set<uint64_t> values;
+};
+
+template <>
+class FilterValueSet<ZeekInetAddress> {
+public:
+	void Insert(const ZeekInetAddress &value) {
+		values.insert(value);
+	}
+	bool Contains(const ZeekInetAddress &value) const {
+		return values.find(value) != values.end();
+	}
+
+private:
+	std::unordered_set<ZeekInetAddress, ZeekInetAddressHash> values;
+};
+
+enum class FilterNodeType : uint8_t {
+	ALWAYS_TRUE,
+	ALWAYS_FALSE,
+	IS_NULL,
+	IS_NOT_NULL,
+	COMPARE,
+	IN,
+	AND,
+	OR,
+	//! The value lies within / contains the constant network (INET `<<=` / `>>=`).
+	CONTAINED_BY,
+	CONTAINS,
+	//! The value matches a LIKE pattern whose only wildcard is `%` (including prefix, suffix and
+	//! contains).
+	MATCH
+};
+
+//! One node of a compiled filter tree, mirroring the TableFilter it was compiled from.
+template <class T>
+struct FilterNode {
+	FilterNodeType type = FilterNodeType::ALWAYS_TRUE;
+	//! For COMPARE: the comparison and its (converted) constant. For CONTAINED_BY / CONTAINS: the
+	//! network.
+	ExpressionType comparison = ExpressionType::INVALID;
+	T constant;
+	//! For IN: the non-NULL constants.
+	FilterValueSet<T> in_values;
+	//! For MATCH: the literal parts of the pattern between its `%`s, and whether the first / last
+	//! part must be at the start / end of the value (i.e. the pattern doesn't start / end with `%`).
+	vector<string> segments;
+	bool anchor_start = false;
+	bool anchor_end = false;
+	//! For AND / OR.
+	vector<unique_ptr<FilterNode<T>>> children;
+};
+
+//! Field types of the typed evaluators. Parse reads a field into TYPE, returning false if it isn't a
+//! valid value of the column type; Convert turns a filter constant of the column type into TYPE.
+//! TryCompileExpression recognizes the expression filters a type can evaluate natively.
+struct BaseFilterType {
+	template <class T>
+	static bool TryCompileExpression(const ExpressionFilter &filter, FilterNode<T> &node) {
+		return false;
+	}
+	template <class T>
+	static bool Contains(const T &network, const T &value) {
+		throw InternalException("read_zeek: containment filter on a non-INET column");
+	}
+	template <class T>
+	static bool Match(const FilterNode<T> &node, const T &value) {
+		throw InternalException("read_zeek: pattern filter on a non-VARCHAR column");
+	}
+};
+
+//! The column and constant of a two-argument function filter, e.g. `prefix(column, 'abc')`. Returns
+//! null unless one argument is the column and the other a non-NULL constant; `column_first` tells
+//! which way round they are.
+static optional_ptr<const Value> GetFunctionConstant(const ExpressionFilter &filter, bool &column_first) {
+	if (filter.expr->GetExpressionClass() != ExpressionClass::BOUND_FUNCTION) {
+		return nullptr;
+	}
+	auto &function = filter.expr->Cast<BoundFunctionExpression>();
+	if (function.children.size() != 2) {
+		return nullptr;
+	}
+	auto &lhs = *function.children[0];
+	auto &rhs = *function.children[1];
+	if (lhs.GetExpressionClass() == ExpressionClass::BOUND_REF &&
+	    rhs.GetExpressionClass() == ExpressionClass::BOUND_CONSTANT) {
+		column_first = true;
+	} else if (lhs.GetExpressionClass() == ExpressionClass::BOUND_CONSTANT &&
+	           rhs.GetExpressionClass() == ExpressionClass::BOUND_REF) {
+		column_first = false;
+	} else {
+		return nullptr;
+	}
+	auto &constant = (column_first ? rhs : lhs).Cast<BoundConstantExpression>().value;
+	if (constant.IsNull()) {
+		return nullptr;
+	}
+	return &constant;
+}
+
+//! Position of `needle` in [data + pos, data + end), or end if it doesn't occur there.
+static idx_t FindSegment(const char *data, idx_t pos, idx_t end, const string &needle) {
+	const idx_t len = needle.size();
+	while (pos + len <= end) {
+		auto first = static_cast<const char *>(std::memchr(data + pos, needle[0], end - len - pos + 1));
+		if (!first) {
+			break;
+		}
+		pos = static_cast<idx_t>(first - data);
+		if (std::memcmp(first, needle.data(), len) == 0) {
+			return pos;
+		}
+		pos++;
+	}
+	return end;
+}
+
+struct VarcharFilterType : public BaseFilterType {
+	typedef string_t TYPE;
+	static bool Parse(const FieldSlice &field, string_t &result) {
+		result = string_t(field.ptr, field.len);
+		return true;
+	}
+	static string_t Convert(const Value &constant, StringHeap &heap) {
+		return heap.AddString(StringValue::Get(constant));
+	}
+	//! Recognize prefix / suffix / contains (and their starts_with / ends_with aliases) on the column,
+	//! and LIKE with a constant pattern whose only wildcard is `%`.
+	static bool TryCompileExpression(const ExpressionFilter &filter, FilterNode<string_t> &node) {
+		bool column_first;
+		auto constant = GetFunctionConstant(filter, column_first);
+		if (!constant || constant->type().id() != LogicalTypeId::VARCHAR || !column_first) {
+			return false;
+		}
+		auto &name = filter.expr->Cast<BoundFunctionExpression>().function.name;
+		auto &text = StringValue::Get(*constant);
+		if (name == "prefix" || name == "starts_with") {
+			node.anchor_start = true;
+		} else if (name == "suffix" || name == "ends_with") {
+			node.anchor_end = true;
+		} else if (name != "contains") {
+			if (name != "~~" || text.find_first_of("_\\") != string::npos) {
+				return false;
+			}
+			node.anchor_start = text.empty() || text.front() != '%';
+			node.anchor_end = text.empty() || text.back() != '%';
+			for (auto &segment : StringUtil::Split(text, '%')) {
+				if (!segment.empty()) {
+					node.segments.push_back(segment);
+				}
+			}
+			node.type = FilterNodeType::MATCH;
+			return true;
+		}
+		if (!text.empty()) {
+			node.segments.push_back(text);
+		}
+		node.type = FilterNodeType::MATCH;
+		return true;
+	}
+	static bool Match(const FilterNode<string_t> &node, const string_t &value) {
+		const char *data = value.GetData();
+		const idx_t len = value.GetSize();
+		auto &segments = node.segments;
+		if (segments.empty()) {
+			// `%` matches anything, an empty pattern only the empty string.
+			return !(node.anchor_start && node.anchor_end) || len == 0;
+		}
+		idx_t pos = 0;
+		idx_t end = len;
+		idx_t first = 0;
+		idx_t last = segments.size();
+		if (node.anchor_start) {
+			auto &segment = segments[first++];
+			if (segment.size() > len || std::memcmp(data, segment.data(), segment.size()) != 0) {
+				return false;
+			}
+			pos = segment.size();
+			if (node.anchor_end && first == last) {
+				// No `%` at all.
+				return pos == len;
+			}
+		}
+		if (node.anchor_end) {
+			auto &segment = segments[--last];
+			if (segment.size() > len - pos ||
+			    std::memcmp(data + len - segment.size(), segment.data(), segment.size()) != 0) {
+				return false;
+			}
+			end = len - segment.size();
+		}
+		for (idx_t i = first; i < last; i++) {
+			const idx_t found = FindSegment(data, pos, end, segments[i]);
+			if (found == end) {
+				return false;
+			}
+			pos = found + segments[i].size();
+		}
+		return true;
+	}
+};
+
+template <class T>
+struct NumericFilterType : public BaseFilterType {
+	typedef T TYPE;
+	static bool Parse(const FieldSlice &field, T &result) {
+		return TryCast::Operation<string_t, T>(string_t(field.ptr, field.len), result);
+	}
+	static T Convert(const Value &constant, StringHeap &heap) {
+		return constant.GetValue<T>();
+	}
+};
+
+struct BooleanFilterType : public BaseFilterType {
+	typedef bool TYPE;
+	static bool Parse(const FieldSlice &field, bool &result) {
+		result = (field.len == 1 && field.ptr[0] == 'T') || (field.len == 4 && std::memcmp(field.ptr, "true", 4) == 0);
+		return true;
+	}
+	static bool Convert(const Value &constant, StringHeap &heap) {
+		return constant.GetValue<bool>();
+	}
+};
+
+//! TIMESTAMP_TZ values are compared as epoch microseconds.
+struct TimestampFilterType : public BaseFilterType {
+	typedef int64_t TYPE;
+	static bool Parse(const FieldSlice &field, int64_t &result) {
+		return ZeekReader::TryParseMicros(field.ptr, field.len, result);
+	}
+	static int64_t Convert(const Value &constant, StringHeap &heap) {
+		return constant.GetValueUnsafe<int64_t>();
+	}
+};
+
+struct InetFilterType : public BaseFilterType {
+	typedef ZeekInetAddress TYPE;
+	static bool Parse(const FieldSlice &field, ZeekInetAddress &result) {
+		return ZeekInet::Parse(field.ptr, field.len, result);
+	}
+	static ZeekInetAddress Convert(const Value &constant, StringHeap &heap) {
+		return ZeekInet::FromValue(constant);
+	}
+	//! Recognize subnet containment, `column <<= constant` / `column >>= constant` (either way round).
+	static bool TryCompileExpression(const ExpressionFilter &filter, FilterNode<ZeekInetAddress> &node) {
+		bool column_first;
+		auto constant = GetFunctionConstant(filter, column_first);
+		if (!constant || !ZeekInet::IsInetType(constant->type())) {
+			return false;
+		}
+		auto &name = filter.expr->Cast<BoundFunctionExpression>().function.name;
+		bool contained_by;
+		if (name == "<<=") {
+			contained_by = column_first;
+		} else if (name == ">>=") {
+			contained_by = !column_first;
+		} else {
+			return false;
+		}
+		node.type = contained_by ? FilterNodeType::CONTAINED_BY : FilterNodeType::CONTAINS;
+		node.constant = ZeekInet::FromValue(*constant);
+		return true;
+	}
+	static bool Contains(const ZeekInetAddress &network, const ZeekInetAddress &value) {
+		return ZeekInet::Contains(network, value);
+	}
+};
+
+static bool IsSupportedComparison(ExpressionType comparison) {
+	switch (comparison) {
+	case ExpressionType::COMPARE_EQUAL:
+	case ExpressionType::COMPARE_NOTEQUAL:
+	case ExpressionType::COMPARE_LESSTHAN:
+	case ExpressionType::COMPARE_GREATERTHAN:
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return true;
+	default:
+		return false;
+	}
+}
+
+//! Filter evaluated on values parsed by FILTER_TYPE.
+template <class FILTER_TYPE>
+class TypedColumnFilter : public ZeekColumnFilter {
+	typedef typename FILTER_TYPE::TYPE T;
+
+public:
+	//! Returns nullptr if any part of `filter` has no typed equivalent.
+	static unique_ptr<ZeekColumnFilter> TryCompile(const TableFilter &filter, const LogicalType &type) {
+		auto result = make_uniq<TypedColumnFilter<FILTER_TYPE>>();
+		result->root = result->CompileNode(filter, type);
+		if (!result->root) {
+			return nullptr;
+		}
+		result->null_result = EvaluateNull(*result->root);
+		return std::move(result);
+	}
+
+	bool Evaluate(const FieldSlice &field) const override {
+		T value;
+		if (!FILTER_TYPE::Parse(field, value)) {
+			return null_result;
+		}
+		return EvaluateNode(*root, value);
+	}
+
+private:
+	unique_ptr<FilterNode<T>> CompileNode(const TableFilter &filter, const LogicalType &type) {
+		auto node = make_uniq<FilterNode<T>>();
+		switch (filter.filter_type) {
+		case TableFilterType::IS_NULL:
+			node->type = FilterNodeType::IS_NULL;
+			break;
+		case TableFilterType::IS_NOT_NULL:
+			node->type = FilterNodeType::IS_NOT_NULL;
+			break;
+		case TableFilterType::CONSTANT_COMPARISON: {
+			auto &constant_filter = filter.Cast<ConstantFilter>();
+			if (!IsSupportedComparison(constant_filter.comparison_type) || constant_filter.constant.type() != type) {
+				return nullptr;
+			}
+			if (constant_filter.constant.IsNull()) {
+				// Comparing with NULL is never true.
+				node->type = FilterNodeType::ALWAYS_FALSE;
+				break;
+			}
+			node->type = FilterNodeType::COMPARE;
+			node->comparison = constant_filter.comparison_type;
+			node->constant = FILTER_TYPE::Convert(constant_filter.constant, heap);
+			break;
+		}
+		case TableFilterType::IN_FILTER: {
+			node->type = FilterNodeType::IN;
+			for (auto &constant : filter.Cast<InFilter>().values) {
+				if (constant.type() != type) {
+					return nullptr;
+				}
+				if (!constant.IsNull()) {
+					node->in_values.Insert(FILTER_TYPE::Convert(constant, heap));
+				}
+			}
+			break;
+		}
+		case TableFilterType::CONJUNCTION_AND:
+		case TableFilterType::CONJUNCTION_OR: {
+			const bool is_and = filter.filter_type == TableFilterType::CONJUNCTION_AND;
+			auto &child_filters = is_and ? filter.Cast<ConjunctionAndFilter>().child_filters
+			                             : filter.Cast<ConjunctionOrFilter>().child_filters;
+			node->type = is_and ? FilterNodeType::AND : FilterNodeType::OR;
+			for (auto &child : child_filters) {
+				auto child_node = CompileNode(*child, type);
+				if (!child_node) {
+					return nullptr;
+				}
+				node->children.push_back(std::move(child_node));
+			}
+			break;
+		}
+		case TableFilterType::EXPRESSION_FILTER:
+			if (!FILTER_TYPE::TryCompileExpression(filter.Cast<ExpressionFilter>(), *node)) {
+				return nullptr;
+			}
+			break;
+		case TableFilterType::OPTIONAL_FILTER: {
+			// An optional filter (e.g. the IN list of a join's build side) may be skipped, so one without
+			// a typed equivalent lets every row through rather than falling back to Values.
+			auto &child = filter.Cast<OptionalFilter>().child_filter;
+			auto child_node = child ? CompileNode(*child, type) : nullptr;
+			if (child_node) {
+				return child_node;
+			}
+			node->type = FilterNodeType::ALWAYS_TRUE;
+			break;
+		}
+		case TableFilterType::DYNAMIC_FILTER:
+			// Its constant changes while the scan runs; threads evaluate it through ZeekDynamicFilter.
+			node->type = FilterNodeType::ALWAYS_TRUE;
+			break;
+		default:
+			// Unknown filter type — be safe: let the row through (as EvaluateFilter does).
+			node->type = FilterNodeType::ALWAYS_TRUE;
+			break;
+		}
+		return node;
+	}
+
+	static bool Compare(ExpressionType comparison, const T &value, const T &constant) {
+		switch (comparison) {
+		case ExpressionType::COMPARE_EQUAL:
+			return Equals::Operation(value, constant);
+		case ExpressionType::COMPARE_NOTEQUAL:
+			return NotEquals::Operation(value, constant);
+		case ExpressionType::COMPARE_LESSTHAN:
+			return LessThan::Operation(value, constant);
+		case ExpressionType::COMPARE_GREATERTHAN:
+			return GreaterThan::Operation(value, constant);
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			return LessThanEquals::Operation(value, constant);
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			return GreaterThanEquals::Operation(value, constant);
+		default:
+			throw InternalException("read_zeek: unsupported comparison in compiled filter");
+		}
+	}
+
+	static bool EvaluateNode(const FilterNode<T> &node, const T &value) {
+		switch (node.type) {
+		case FilterNodeType::ALWAYS_TRUE:
+		case FilterNodeType::IS_NOT_NULL:
+			return true;
+		case FilterNodeType::ALWAYS_FALSE:
+		case FilterNodeType::IS_NULL:
+			return false;
+		case FilterNodeType::COMPARE:
+			return Compare(node.comparison, value, node.constant);
+		case FilterNodeType::IN:
+			return node.in_values.Contains(value);
+		case FilterNodeType::CONTAINED_BY:
+			return FILTER_TYPE::Contains(node.constant, value);
+		case FilterNodeType::CONTAINS:
+			return FILTER_TYPE::Contains(value, node.constant);
+		case FilterNodeType::MATCH:
+			return FILTER_TYPE::Match(node, value);
+		case FilterNodeType::AND:
+			for (auto &child : node.children) {
+				if (!EvaluateNode(*child, value)) {
+					return false;
+				}
+			}
+			return true;
+		case FilterNodeType::OR:
+			for (auto &child : node.children) {
+				if (EvaluateNode(*child, value)) {
+					return true;
+				}
+			}
+			return false;
+		default:
+			throw InternalException("read_zeek: unknown compiled filter node");
+		}
+	}
+
+	//! The result on a NULL field only depends on the shape of the filter, so it is computed once.
+	static bool EvaluateNull(const FilterNode<T> &node) {
+		switch (node.type) {
+		case FilterNodeType::ALWAYS_TRUE:
+		case FilterNodeType::IS_NULL:
+			return true;
+		case FilterNodeType::AND:
+			for (auto &child : node.children) {
+				if (!EvaluateNull(*child)) {
+					return false;
+				}
+			}
+			return true;
+		case FilterNodeType::OR:
+			for (auto &child : node.children) {
+				if (EvaluateNull(*child)) {
+					return true;
+				}
+			}
+			return false;
+		default:
+			return false;
+		}
+	}
+
+	unique_ptr<FilterNode<T>> root;
+	//! Owns the VARCHAR constants referenced by the tree.
+	StringHeap heap;
+};
+
+unique_ptr<ZeekColumnFilter> ZeekColumnFilter::Compile(const TableFilter &filter, const LogicalType &type) {
+	unique_ptr<ZeekColumnFilter> result;
+	switch (type.id()) {
+	case LogicalTypeId::VARCHAR:
+		result = TypedColumnFilter<VarcharFilterType>::TryCompile(filter, type);
+		break;
+	case LogicalTypeId::DOUBLE:
+		result = TypedColumnFilter<NumericFilterType<double>>::TryCompile(filter, type);
+		break;
+	case LogicalTypeId::UBIGINT:
+		result = TypedColumnFilter<NumericFilterType<uint64_t>>::TryCompile(filter, type);
+		break;
+	case LogicalTypeId::BIGINT:
+		result = TypedColumnFilter<NumericFilterType<int64_t>>::TryCompile(filter, type);
+		break;
+	case LogicalTypeId::USMALLINT:
+		result = TypedColumnFilter<NumericFilterType<uint16_t>>::TryCompile(filter, type);
+		break;
+	case LogicalTypeId::BOOLEAN:
+		result = TypedColumnFilter<BooleanFilterType>::TryCompile(filter, type);
+		break;
+	case LogicalTypeId::TIMESTAMP_TZ:
+		result = TypedColumnFilter<TimestampFilterType>::TryCompile(filter, type);
+		break;
+	case LogicalTypeId::STRUCT:
+		if (ZeekInet::IsInetType(type)) {
+			result = TypedColumnFilter<InetFilterType>::TryCompile(filter, type);
+		}
+		break;
+	default:
+		break;
+	}
+	if (!result) {
+		result = make_uniq<ValueColumnFilter>(filter, type);
+	}
+	return result;
+}
+
+ZeekDynamicFilter::ZeekDynamicFilter(shared_ptr<DynamicFilterData> data_p, LogicalType type_p)
+    : data(std::move(data_p)), type(std::move(type_p)) {
+}
+
+optional_ptr<const ZeekColumnFilter> ZeekDynamicFilter::Refresh() {
+	lock_guard<mutex> guard(data->lock);
+	if (!data->initialized || !data->filter) {
+		compiled.reset();
+		return nullptr;
+	}
+	auto &filter = *data->filter;
+	if (!compiled || filter.comparison_type != current->comparison_type || filter.constant != current->constant) {
+		current = make_uniq<ConstantFilter>(filter.comparison_type, filter.constant);
+		compiled = ZeekColumnFilter::Compile(*current, type);
+	}
+	return compiled.get();
+}
+
+void ZeekDynamicFilter::Collect(const TableFilter &filter, vector<shared_ptr<DynamicFilterData>> &result) {
+	switch (filter.filter_type) {
+	case TableFilterType::DYNAMIC_FILTER: {
+		auto &filter_data = filter.Cast<DynamicFilter>().filter_data;
+		if (filter_data) {
+			result.push_back(filter_data);
+		}
+		break;
+	}
+	case TableFilterType::OPTIONAL_FILTER: {
+		auto &child = filter.Cast<OptionalFilter>().child_filter;
+		if (child) {
+			Collect(*child, result);
+		}
+		break;
+	}
+	case TableFilterType::CONJUNCTION_AND:
+		for (auto &child : filter.Cast<ConjunctionAndFilter>().child_filters) {
+			Collect(*child, result);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+} // namespace duckdb
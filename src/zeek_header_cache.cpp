@@ -0,0 +1,139 @@
+#include "zeek_header_cache.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+
+namespace duckdb {
+
+//! Number of files whose headers one task reads (or that one task stats).
+static constexpr idx_t HEADER_TASK_FILE_COUNT = 8;
+
+optional_idx ZeekHeaderCacheEntry::GetEstimatedCacheMemory() const {
+	idx_t size = sizeof(ZeekHeader) + header->empty_field.size() + header->unset_field.size() +
+	             header->path.size() + header->open_time.size();
+	for (idx_t i = 0; i < header->fields.size(); i++) {
+		size += sizeof(string) * 2 + header->fields[i].size() + header->types[i].size();
+	}
+	return optional_idx(size);
+}
+
+shared_ptr<const ZeekHeader> ZeekHeaderCache::GetHeader(ClientContext &context, const string &path) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto &cache = ObjectCache::GetObjectCache(context);
+
+	// Stat the raw file: for compressed files, this avoids setting up a decompressor on a cache hit.
+	idx_t size;
+	int64_t mtime;
+	{
+		auto raw_handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+		size = fs.GetFileSize(*raw_handle);
+		mtime = fs.GetLastModifiedTime(*raw_handle).value;
+	}
+	const string key = StringUtil::Format("zeek_header:%s:%llu:%lld", path, static_cast<unsigned long long>(size),
+	                                      static_cast<long long>(mtime));
+	auto entry = cache.Get<ZeekHeaderCacheEntry>(key);
+	if (entry) {
+		return entry->header;
+	}
+
+	auto file_handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ | FileCompressionType::AUTO_DETECT);
+	auto header = ZeekReader::ParseHeader(*file_handle);
+	header.source_size = size;
+	header.source_mtime = mtime;
+	entry = make_shared_ptr<ZeekHeaderCacheEntry>(std::move(header));
+	cache.Put(key, entry);
+	return entry->header;
+}
+
+//! Reads the headers of files [start, end).
+class ZeekHeaderTask : public BaseExecutorTask {
+public:
+	ZeekHeaderTask(TaskExecutor &executor, ClientContext &context, const vector<string> &paths, idx_t start,
+	               idx_t end, vector<shared_ptr<const ZeekHeader>> &headers, vector<ErrorData> &errors)
+	    : BaseExecutorTask(executor), context(context), paths(paths), start(start), end(end), headers(headers),
+	      errors(errors) {
+	}
+
+	void ExecuteTask() override {
+		for (idx_t file_idx = start; file_idx < end; file_idx++) {
+			try {
+				headers[file_idx] = ZeekHeaderCache::GetHeader(context, paths[file_idx]);
+			} catch (std::exception &ex) {
+				errors[file_idx] = ErrorData(ex);
+			}
+		}
+	}
+
+	string TaskType() const override {
+		return "ZeekHeaderTask";
+	}
+
+private:
+	ClientContext &context;
+	const vector<string> &paths;
+	const idx_t start;
+	const idx_t end;
+	vector<shared_ptr<const ZeekHeader>> &headers;
+	vector<ErrorData> &errors;
+};
+
+void ZeekHeaderCache::GetHeaders(ClientContext &context, const vector<string> &paths,
+                                 vector<shared_ptr<const ZeekHeader>> &headers, vector<ErrorData> &errors) {
+	headers.assign(paths.size(), nullptr);
+	errors.assign(paths.size(), ErrorData());
+	// Each task writes only its own slots, so the results don't depend on scheduling.
+	TaskExecutor executor(context);
+	for (idx_t start = 0; start < paths.size(); start += HEADER_TASK_FILE_COUNT) {
+		const idx_t end = MinValue<idx_t>(start + HEADER_TASK_FILE_COUNT, paths.size());
+		executor.ScheduleTask(make_uniq<ZeekHeaderTask>(executor, context, paths, start, end, headers, errors));
+	}
+	executor.WorkOnTasks();
+}
+
+//! Stats the files at positions [start, end) of `file_indexes`.
+class ZeekFileSizeTask : public BaseExecutorTask {
+public:
+	ZeekFileSizeTask(TaskExecutor &executor, ClientContext &context, const vector<string> &paths,
+	                 const vector<idx_t> &file_indexes, idx_t start, idx_t end, vector<idx_t> &sizes)
+	    : BaseExecutorTask(executor), context(context), paths(paths), file_indexes(file_indexes), start(start),
+	      end(end), sizes(sizes) {
+	}
+
+	void ExecuteTask() override {
+		auto &fs = FileSystem::GetFileSystem(context);
+		for (idx_t i = start; i < end; i++) {
+			const idx_t file_idx = file_indexes[i];
+			try {
+				auto handle = fs.OpenFile(paths[file_idx], FileFlags::FILE_FLAGS_READ);
+				if (handle->CanSeek()) {
+					sizes[file_idx] = fs.GetFileSize(*handle);
+				}
+			} catch (std::exception &ex) {
+				// Left unsized; the scan reports (or skips) the file's error when it opens it.
+			}
+		}
+	}
+
+	string TaskType() const override {
+		return "ZeekFileSizeTask";
+	}
+
+private:
+	ClientContext &context;
+	const vector<string> &paths;
+	const vector<idx_t> &file_indexes;
+	const idx_t start;
+	const idx_t end;
+	vector<idx_t> &sizes;
+};
+
+void ZeekHeaderCache::GetFileSizes(ClientContext &context, const vector<string> &paths,
+                                   const vector<idx_t> &file_indexes, vector<idx_t> &sizes) {
+	TaskExecutor executor(context);
+	for (idx_t start = 0; start < file_indexes.size(); start += HEADER_TASK_FILE_COUNT) {
+		const idx_t end = MinValue<idx_t>(start + HEADER_TASK_FILE_COUNT, file_indexes.size());
+		executor.ScheduleTask(make_uniq<ZeekFileSizeTask>(executor, context, paths, file_indexes, start, end, sizes));
+	}
+	executor.WorkOnTasks();
+}
+
+} // namespace duckdb
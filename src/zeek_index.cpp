@@ -0,0 +1,532 @@
+#include "zeek_index.hpp"
+#include "zeek_header_cache.hpp"
+#include "zeek_json.hpp"
+#include "zeek_reader.hpp"
+#include "zeek_tokenizer.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/enums/file_compression_type.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/function/table_function.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace duckdb {
+
+static constexpr idx_t INDEX_READ_SIZE = 65536; // 64KB
+static constexpr idx_t DEFAULT_ROWS_PER_ENTRY = 16384;
+static constexpr const char *SIDECAR_EXTENSION = ".zidx";
+static constexpr const char *INDEX_VERSION = "1";
+
+static inline bool SliceEquals(const FieldSlice &s, const string &str) {
+	return s.len == str.size() && std::memcmp(s.ptr, str.data(), s.len) == 0;
+}
+
+//! Builds the entries of an index from the (decompressed) bytes of a log, fed front to back.
+class ZeekIndexBuilder {
+public:
+	//! With `split_at_lines`, an entry ends at the first newline after it fills up; otherwise only at
+	//! the boundaries passed to AddBlockBoundary.
+	ZeekIndexBuilder(const ZeekHeader &header, idx_t rows_per_entry, bool split_at_lines)
+	    : header(header), rows_per_entry(rows_per_entry), split_at_lines(split_at_lines) {
+		for (idx_t i = 0; i < header.fields.size(); i++) {
+			if (header.fields[i] == "ts" && header.types[i] == "time") {
+				ts_field = i;
+				break;
+			}
+		}
+		if (header.json && ts_field != DConstants::INVALID_INDEX) {
+			json_ts_field = make_uniq<ZeekJsonFieldMap>(vector<string> {"ts"});
+		}
+		current = {0, 0, 0, 0, 0, 0};
+	}
+
+	//! Index the next `size` bytes of the stream.
+	void AddChunk(const char *data, idx_t size) {
+		idx_t pos = 0;
+		while (pos < size) {
+			auto newline = static_cast<const char *>(std::memchr(data + pos, '\n', size - pos));
+			if (!newline) {
+				line_buffer.insert(line_buffer.end(), data + pos, data + size);
+				break;
+			}
+			const idx_t len = static_cast<idx_t>(newline - (data + pos));
+			if (line_buffer.empty()) {
+				AddLine(data + pos, len);
+			} else {
+				line_buffer.insert(line_buffer.end(), data + pos, newline);
+				AddLine(line_buffer.data(), line_buffer.size());
+				line_buffer.clear();
+			}
+			pos += len + 1;
+			if (split_at_lines) {
+				// A byte range ending at the newline leaves the next line to the next range.
+				const idx_t newline_offset = stream_offset + pos - 1;
+				OfferEnd(newline_offset, newline_offset);
+			}
+			line_start = stream_offset + pos;
+		}
+		stream_offset += size;
+	}
+
+	//! The stream has reached the start of block `block_idx`.
+	void AddBlockBoundary(idx_t block_idx) {
+		OfferEnd(stream_offset, block_idx);
+	}
+
+	//! Finish the last entry at `end` and return the entries.
+	vector<ZeekIndexEntry> Finish(idx_t end) {
+		if (!line_buffer.empty()) {
+			AddLine(line_buffer.data(), line_buffer.size());
+		}
+		current.end = end;
+		entries.push_back(current);
+		return std::move(entries);
+	}
+
+private:
+	//! Account for the line (without its newline) starting at stream offset `line_start`.
+	void AddLine(const char *line, idx_t len) {
+		if (has_pending_end && line_start > pending_end_offset) {
+			current.end = pending_end;
+			entries.push_back(current);
+			current = {pending_end, 0, 0, 0, 0, 0};
+			has_pending_end = false;
+		}
+		if (len > 0 && line[len - 1] == '\r') {
+			len--;
+		}
+		if (len == 0 || line[0] == '#') {
+			return;
+		}
+		current.row_count++;
+		int64_t ts;
+		if (ParseTimestamp(line, len, ts)) {
+			if (current.ts_count == 0 || ts < current.min_ts) {
+				current.min_ts = ts;
+			}
+			if (current.ts_count == 0 || ts > current.max_ts) {
+				current.max_ts = ts;
+			}
+			current.ts_count++;
+		}
+	}
+
+	//! End the current entry at `position` once it is full. Lines starting at or before stream offset
+	//! `offset` (e.g. one already in progress) still belong to it.
+	void OfferEnd(idx_t offset, idx_t position) {
+		if (!has_pending_end && current.row_count >= rows_per_entry) {
+			has_pending_end = true;
+			pending_end_offset = offset;
+			pending_end = position;
+		}
+	}
+
+	//! Parse the line's `ts` field like the scanner does. Returns false if it is NULL.
+	bool ParseTimestamp(const char *line, idx_t len, int64_t &ts) {
+		if (ts_field == DConstants::INVALID_INDEX) {
+			return false;
+		}
+		idx_t slice_idx = ts_field;
+		if (json_ts_field) {
+			ZeekJson::TokenizeLine(line, len, *json_ts_field, field_slices, json_scratch);
+			slice_idx = 0;
+		} else {
+			ZeekTokenizer::TokenizeLine(line, len, header.separator, field_slices, ts_field + 1);
+		}
+		if (field_slices.size() <= slice_idx) {
+			return false;
+		}
+		const FieldSlice &field = field_slices[slice_idx];
+		const ZeekHeader &markers = json_ts_field ? ZeekJson::Markers() : header;
+		if (SliceEquals(field, markers.unset_field) || SliceEquals(field, markers.empty_field)) {
+			return false;
+		}
+		return ZeekReader::TryParseMicros(field.ptr, field.len, ts);
+	}
+
+	const ZeekHeader &header;
+	const idx_t rows_per_entry;
+	const bool split_at_lines;
+	//! Field index of `ts` (a Zeek `time`), or INVALID_INDEX if the log has none.
+	idx_t ts_field = DConstants::INVALID_INDEX;
+	//! For JSON logs, the field map that picks just `ts` out of each line.
+	unique_ptr<ZeekJsonFieldMap> json_ts_field;
+	vector<char> json_scratch;
+
+	vector<ZeekIndexEntry> entries;
+	ZeekIndexEntry current;
+	//! Once `current` is full: the position it ends at, and the offset after which lines belong to the
+	//! next entry.
+	bool has_pending_end = false;
+	idx_t pending_end_offset = 0;
+	idx_t pending_end = 0;
+
+	//! Stream offset of the next chunk, and of the first byte of the line in progress.
+	idx_t stream_offset = 0;
+	idx_t line_start = 0;
+	//! The start of a line that spans chunks.
+	vector<char> line_buffer;
+	vector<FieldSlice> field_slices;
+};
+
+string ZeekIndex::SidecarPath(const string &path) {
+	return path + SIDECAR_EXTENSION;
+}
+
+bool ZeekIndex::IsSidecarPath(const string &path) {
+	return StringUtil::EndsWith(StringUtil::Lower(path), SIDECAR_EXTENSION);
+}
+
+ZeekFileIndex ZeekIndex::Build(ClientContext &context, const string &path, idx_t rows_per_entry) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto header = ZeekHeaderCache::GetHeader(context, path);
+
+	ZeekFileIndex index;
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	index.source_size = fs.GetFileSize(*handle);
+	index.source_mtime = fs.GetLastModifiedTime(*handle).value;
+	vector<char> buffer(INDEX_READ_SIZE);
+
+	if (ZeekReader::IsCompressedPath(path)) {
+		vector<ZeekCompressedBlock> blocks;
+		index.block_format = ZeekBlockCodec::DetectBlocks(*handle, blocks);
+		if (index.block_format != ZeekBlockFormat::NONE) {
+			// Decode block by block, so that entries can end at block boundaries.
+			index.layout = ZeekIndexLayout::BLOCK_RUNS;
+			ZeekIndexBuilder builder(*header, rows_per_entry, false);
+			vector<char> compressed;
+			for (idx_t block_idx = 0; block_idx < blocks.size(); block_idx++) {
+				auto &block = blocks[block_idx];
+				if (block.decompressed_size > 0) {
+					compressed.resize(block.compressed_size);
+					handle->Read(compressed.data(), block.compressed_size, block.offset);
+					idx_t size = ZeekBlockCodec::DecompressBlock(index.block_format, block, compressed.data(), buffer);
+					builder.AddChunk(buffer.data(), size);
+				}
+				builder.AddBlockBoundary(block_idx + 1);
+			}
+			index.entries = builder.Finish(blocks.size());
+			return index;
+		}
+		index.layout = ZeekIndexLayout::STREAM;
+		handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ | FileCompressionType::AUTO_DETECT);
+	} else {
+		index.layout = ZeekIndexLayout::BYTE_RANGES;
+	}
+
+	ZeekIndexBuilder builder(*header, rows_per_entry, index.layout == ZeekIndexLayout::BYTE_RANGES);
+	while (true) {
+		auto bytes_read = handle->Read(buffer.data(), buffer.size());
+		if (bytes_read <= 0) {
+			break;
+		}
+		builder.AddChunk(buffer.data(), static_cast<idx_t>(bytes_read));
+	}
+	index.entries = builder.Finish(index.layout == ZeekIndexLayout::BYTE_RANGES ? index.source_size : 0);
+	return index;
+}
+
+static const char *LayoutName(const ZeekFileIndex &index) {
+	switch (index.layout) {
+	case ZeekIndexLayout::STREAM:
+		return "stream";
+	case ZeekIndexLayout::BYTE_RANGES:
+		return "ranges";
+	case ZeekIndexLayout::BLOCK_RUNS:
+		return index.block_format == ZeekBlockFormat::BGZF ? "bgzf" : "seekable_zstd";
+	default:
+		throw InternalException("read_zeek: unknown index layout");
+	}
+}
+
+static bool ParseLayout(const string &name, ZeekFileIndex &index) {
+	if (name == "stream") {
+		index.layout = ZeekIndexLayout::STREAM;
+	} else if (name == "ranges") {
+		index.layout = ZeekIndexLayout::BYTE_RANGES;
+	} else if (name == "bgzf") {
+		index.layout = ZeekIndexLayout::BLOCK_RUNS;
+		index.block_format = ZeekBlockFormat::BGZF;
+	} else if (name == "seekable_zstd") {
+		index.layout = ZeekIndexLayout::BLOCK_RUNS;
+		index.block_format = ZeekBlockFormat::SEEKABLE_ZSTD;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+// The sidecar is a small TSV file laid out like a Zeek log:
+//   #zeek_index	1
+//   #layout	ranges
+//   #source	<size>	<mtime>
+//   #fields	start	end	rows	ts_rows	min_ts	max_ts
+//   0	2097151	16384	16384	1768540789000000	1768541027000000
+//   ...
+// with ts values in microseconds since the epoch ('-' if the entry has no ts).
+void ZeekIndex::Write(FileSystem &fs, const string &path, const ZeekFileIndex &index) {
+	string contents;
+	contents += StringUtil::Format("#zeek_index\t%s\n#layout\t%s\n#source\t%llu\t%lld\n", INDEX_VERSION,
+	                               LayoutName(index), static_cast<unsigned long long>(index.source_size),
+	                               static_cast<long long>(index.source_mtime));
+	contents += "#fields\tstart\tend\trows\tts_rows\tmin_ts\tmax_ts\n";
+	for (auto &entry : index.entries) {
+		contents += StringUtil::Format("%llu\t%llu\t%llu\t%llu\t", static_cast<unsigned long long>(entry.start),
+		                               static_cast<unsigned long long>(entry.end),
+		                               static_cast<unsigned long long>(entry.row_count),
+		                               static_cast<unsigned long long>(entry.ts_count));
+		if (entry.ts_count == 0) {
+			contents += "-\t-\n";
+		} else {
+			contents += StringUtil::Format("%lld\t%lld\n", static_cast<long long>(entry.min_ts),
+			                               static_cast<long long>(entry.max_ts));
+		}
+	}
+
+	// Written next to the sidecar and moved into place, so that a scan never sees a partial index. The
+	// temporary file is itself named like a sidecar, which keeps it out of globs over the logs.
+	const string temp_path = SidecarPath(path + "." + UUID::ToString(UUID::GenerateRandomUUID()) + ".tmp");
+	try {
+		auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(const_cast<char *>(contents.data()), contents.size());
+		handle->Sync();
+		handle.reset();
+		fs.MoveFile(temp_path, SidecarPath(path));
+	} catch (...) {
+		if (fs.FileExists(temp_path)) {
+			fs.RemoveFile(temp_path);
+		}
+		throw;
+	}
+}
+
+template <class T>
+static bool ParseIndexNumber(const string &text, T &result) {
+	return TryCast::Operation<string_t, T>(string_t(text), result, true);
+}
+
+//! Parse the sidecar `contents` into `index`. Returns false if it is malformed.
+static bool ParseSidecar(const string &contents, ZeekFileIndex &index) {
+	bool has_version = false;
+	bool has_layout = false;
+	bool has_source = false;
+	for (auto &line : StringUtil::Split(contents, '\n')) {
+		auto parts = StringUtil::Split(line, '\t');
+		if (parts.empty()) {
+			continue;
+		}
+		if (parts[0] == "#zeek_index") {
+			if (parts.size() != 2 || parts[1] != INDEX_VERSION) {
+				return false;
+			}
+			has_version = true;
+		} else if (parts[0] == "#layout") {
+			if (parts.size() != 2 || !ParseLayout(parts[1], index)) {
+				return false;
+			}
+			has_layout = true;
+		} else if (parts[0] == "#source") {
+			if (parts.size() != 3 || !ParseIndexNumber(parts[1], index.source_size) ||
+			    !ParseIndexNumber(parts[2], index.source_mtime)) {
+				return false;
+			}
+			has_source = true;
+		} else if (parts[0][0] == '#') {
+			continue;
+		} else {
+			ZeekIndexEntry entry;
+			if (parts.size() != 6 || !ParseIndexNumber(parts[0], entry.start) ||
+			    !ParseIndexNumber(parts[1], entry.end) || !ParseIndexNumber(parts[2], entry.row_count) ||
+			    !ParseIndexNumber(parts[3], entry.ts_count) || entry.ts_count > entry.row_count) {
+				return false;
+			}
+			entry.min_ts = 0;
+			entry.max_ts = 0;
+			if (entry.ts_count > 0 &&
+			    (!ParseIndexNumber(parts[4], entry.min_ts) || !ParseIndexNumber(parts[5], entry.max_ts))) {
+				return false;
+			}
+			index.entries.push_back(entry);
+		}
+	}
+	if (!has_version || !has_layout || !has_source || index.entries.empty()) {
+		return false;
+	}
+
+	// The entries must tile the file.
+	auto &entries = index.entries;
+	if (entries[0].start != 0) {
+		return false;
+	}
+	for (idx_t i = 1; i < entries.size(); i++) {
+		if (entries[i].start != entries[i - 1].end || entries[i].start <= entries[i - 1].start) {
+			return false;
+		}
+	}
+	switch (index.layout) {
+	case ZeekIndexLayout::STREAM:
+		return entries.size() == 1 && entries[0].end == 0;
+	case ZeekIndexLayout::BYTE_RANGES:
+		return entries.back().end == index.source_size;
+	default:
+		return entries.back().end > entries.back().start;
+	}
+}
+
+//! The index in the existing sidecar of the log at `path`, or null if it is stale.
+static shared_ptr<const ZeekFileIndex> ReadSidecar(FileSystem &fs, const string &path) {
+	const string sidecar = ZeekIndex::SidecarPath(path);
+	string contents;
+	{
+		auto handle = fs.OpenFile(sidecar, FileFlags::FILE_FLAGS_READ);
+		contents.resize(fs.GetFileSize(*handle));
+		handle->Read(&contents[0], contents.size());
+	}
+	auto index = make_shared_ptr<ZeekFileIndex>();
+	if (!ParseSidecar(contents, *index)) {
+		throw IOException("read_zeek: malformed index '%s'; rebuild it with zeek_build_index, or pass use_index=false",
+		                  sidecar);
+	}
+
+	// An index of an older version of the file is ignored.
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	if (fs.GetFileSize(*handle) != index->source_size ||
+	    fs.GetLastModifiedTime(*handle).value != index->source_mtime) {
+		return nullptr;
+	}
+	return std::move(index);
+}
+
+shared_ptr<const ZeekFileIndex> ZeekIndex::Load(FileSystem &fs, const string &path) {
+	if (!fs.FileExists(SidecarPath(path))) {
+		return nullptr;
+	}
+	return ReadSidecar(fs, path);
+}
+
+//! Split `path` into its directory (empty for a bare file name) and file name.
+static void SplitPath(const string &path, string &directory, string &name) {
+	auto separator = path.find_last_of("/\\");
+	if (separator == string::npos) {
+		directory = string();
+		name = path;
+	} else {
+		directory = path.substr(0, separator + 1);
+		name = path.substr(separator + 1);
+	}
+}
+
+vector<shared_ptr<const ZeekFileIndex>> ZeekIndex::LoadAll(FileSystem &fs, const vector<string> &paths,
+                                                           bool include_remote) {
+	vector<shared_ptr<const ZeekFileIndex>> result(paths.size());
+	// Per directory, the names of its sidecars, or null if it can't be listed (then the sidecars are
+	// probed for one by one).
+	std::unordered_map<string, unique_ptr<std::unordered_set<string>>> directory_sidecars;
+	for (idx_t i = 0; i < paths.size(); i++) {
+		const string &path = paths[i];
+		if (!include_remote && FileSystem::IsRemoteFile(path)) {
+			continue;
+		}
+		string directory, name;
+		SplitPath(path, directory, name);
+		auto entry = directory_sidecars.find(directory);
+		if (entry == directory_sidecars.end()) {
+			auto sidecars = make_uniq<std::unordered_set<string>>();
+			try {
+				fs.ListFiles(directory.empty() ? "." : directory, [&](const string &file_name, bool is_directory) {
+					if (!is_directory && IsSidecarPath(file_name)) {
+						sidecars->insert(file_name);
+					}
+				});
+			} catch (const std::exception &e) {
+				sidecars.reset();
+			}
+			entry = directory_sidecars.emplace(directory, std::move(sidecars)).first;
+		}
+		if (!entry->second) {
+			result[i] = Load(fs, path);
+		} else if (entry->second->count(SidecarPath(name))) {
+			result[i] = ReadSidecar(fs, path);
+		}
+	}
+	return result;
+}
+
+struct ZeekBuildIndexBindData : public TableFunctionData {
+	vector<string> file_paths;
+	idx_t rows_per_entry = DEFAULT_ROWS_PER_ENTRY;
+};
+
+struct ZeekBuildIndexGlobalState : public GlobalTableFunctionState {
+	idx_t next_file_idx = 0;
+};
+
+static unique_ptr<FunctionData> ZeekBuildIndexBind(ClientContext &context, TableFunctionBindInput &input,
+                                                   vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<ZeekBuildIndexBindData>();
+	string pattern = input.inputs[0].GetValue<string>();
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	for (auto &file_info : fs.Glob(pattern)) {
+		if (!ZeekIndex::IsSidecarPath(file_info.path)) {
+			result->file_paths.push_back(file_info.path);
+		}
+	}
+	if (result->file_paths.empty()) {
+		throw IOException("No files found matching pattern: %s", pattern);
+	}
+	std::sort(result->file_paths.begin(), result->file_paths.end());
+
+	auto rows_per_entry_param = input.named_parameters.find("rows_per_entry");
+	if (rows_per_entry_param != input.named_parameters.end()) {
+		auto rows_per_entry = rows_per_entry_param->second.GetValue<int64_t>();
+		if (rows_per_entry <= 0) {
+			throw InvalidInputException("zeek_build_index: rows_per_entry must be positive");
+		}
+		result->rows_per_entry = static_cast<idx_t>(rows_per_entry);
+	}
+
+	names.push_back("filename");
+	return_types.push_back(LogicalType::VARCHAR);
+	names.push_back("entries");
+	return_types.push_back(LogicalType::UBIGINT);
+	names.push_back("rows");
+	return_types.push_back(LogicalType::UBIGINT);
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> ZeekBuildIndexInitGlobal(ClientContext &context,
+                                                                     TableFunctionInitInput &input) {
+	return make_uniq<ZeekBuildIndexGlobalState>();
+}
+
+//! Index one file per call, emitting a row for it.
+static void ZeekBuildIndexExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<ZeekBuildIndexBindData>();
+	auto &gstate = data.global_state->Cast<ZeekBuildIndexGlobalState>();
+	if (gstate.next_file_idx >= bind_data.file_paths.size()) {
+		output.SetCardinality(0);
+		return;
+	}
+	const string &path = bind_data.file_paths[gstate.next_file_idx++];
+	auto index = ZeekIndex::Build(context, path, bind_data.rows_per_entry);
+	ZeekIndex::Write(FileSystem::GetFileSystem(context), path, index);
+
+	output.SetValue(0, 0, Value(path));
+	output.SetValue(1, 0, Value::UBIGINT(index.entries.size()));
+	output.SetValue(2, 0, Value::UBIGINT(index.RowCount()));
+	output.SetCardinality(1);
+}
+
+TableFunction GetZeekBuildIndexFunction() {
+	TableFunction func("zeek_build_index", {LogicalType::VARCHAR}, ZeekBuildIndexExecute, ZeekBuildIndexBind,
+	                   ZeekBuildIndexInitGlobal);
+	func.named_parameters["rows_per_entry"] = LogicalType::BIGINT;
+	return func;
+}
+
+} // namespace duckdb
@@ -0,0 +1,285 @@
+#include "zeek_inet.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+
+static constexpr uint64_t IPV6_SIGN_FLIP = uint64_t(1) << 63;
+
+static inline bool IsDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+static inline int HexDigitValue(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+//! Parse a dotted quad in data[pos, end) that must run to `end`. Leading zeros are rejected, as they
+//! are ambiguous (some parsers read them as octal).
+static bool ParseIPv4(const char *data, idx_t pos, idx_t end, uint32_t &result) {
+	result = 0;
+	for (idx_t part = 0; part < 4; part++) {
+		if (part > 0) {
+			if (pos >= end || data[pos] != '.') {
+				return false;
+			}
+			pos++;
+		}
+		const idx_t digits_start = pos;
+		uint32_t value = 0;
+		while (pos < end && IsDigit(data[pos]) && pos - digits_start < 3) {
+			value = value * 10 + uint32_t(data[pos] - '0');
+			pos++;
+		}
+		const idx_t digits = pos - digits_start;
+		if (digits == 0 || value > 255 || (digits > 1 && data[digits_start] == '0')) {
+			return false;
+		}
+		result = (result << 8) | value;
+	}
+	return pos == end;
+}
+
+//! Parse an IPv6 address in data[pos, end) into its eight 16-bit groups.
+static bool ParseIPv6(const char *data, idx_t pos, idx_t end, uint64_t &upper, uint64_t &lower) {
+	uint16_t groups[8];
+	idx_t count = 0;
+	idx_t gap = DConstants::INVALID_INDEX;
+
+	if (end - pos >= 2 && data[pos] == ':' && data[pos + 1] == ':') {
+		gap = 0;
+		pos += 2;
+	}
+	while (pos < end) {
+		if (count == 8) {
+			return false;
+		}
+		const idx_t group_start = pos;
+		uint32_t value = 0;
+		while (pos < end && pos - group_start < 4 && HexDigitValue(data[pos]) >= 0) {
+			value = (value << 4) | uint32_t(HexDigitValue(data[pos]));
+			pos++;
+		}
+		if (pos < end && data[pos] == '.') {
+			// Trailing dotted quad (e.g. ::ffff:10.0.0.1) fills the last two groups.
+			uint32_t ipv4;
+			if (count > 6 || !ParseIPv4(data, group_start, end, ipv4)) {
+				return false;
+			}
+			groups[count++] = uint16_t(ipv4 >> 16);
+			groups[count++] = uint16_t(ipv4 & 0xFFFF);
+			pos = end;
+			break;
+		}
+		if (pos == group_start) {
+			return false;
+		}
+		groups[count++] = uint16_t(value);
+		if (pos == end) {
+			break;
+		}
+		if (data[pos] != ':') {
+			return false;
+		}
+		pos++;
+		if (pos < end && data[pos] == ':') {
+			if (gap != DConstants::INVALID_INDEX) {
+				return false;
+			}
+			gap = count;
+			pos++;
+		} else if (pos == end) {
+			// A single trailing colon.
+			return false;
+		}
+	}
+
+	uint16_t expanded[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+	if (gap == DConstants::INVALID_INDEX) {
+		if (count != 8) {
+			return false;
+		}
+		std::copy(groups, groups + 8, expanded);
+	} else {
+		if (count > 7) {
+			return false;
+		}
+		std::copy(groups, groups + gap, expanded);
+		std::copy(groups + gap, groups + count, expanded + 8 - (count - gap));
+	}
+	upper = 0;
+	lower = 0;
+	for (idx_t i = 0; i < 4; i++) {
+		upper = (upper << 16) | expanded[i];
+		lower = (lower << 16) | expanded[i + 4];
+	}
+	return true;
+}
+
+bool ZeekInet::Parse(const char *data, idx_t len, ZeekInetAddress &result) {
+	idx_t address_end = len;
+	for (idx_t i = 0; i < len; i++) {
+		if (data[i] == '/') {
+			address_end = i;
+			break;
+		}
+	}
+
+	bool is_ipv6 = false;
+	for (idx_t i = 0; i < address_end; i++) {
+		if (data[i] == ':') {
+			is_ipv6 = true;
+			break;
+		}
+	}
+	if (is_ipv6) {
+		result.ip_type = IPV6;
+		if (!ParseIPv6(data, 0, address_end, result.upper, result.lower)) {
+			return false;
+		}
+		result.mask = 128;
+	} else {
+		uint32_t ipv4;
+		if (!ParseIPv4(data, 0, address_end, ipv4)) {
+			return false;
+		}
+		result.ip_type = IPV4;
+		result.upper = 0;
+		result.lower = ipv4;
+		result.mask = 32;
+	}
+
+	if (address_end < len) {
+		const idx_t digits_start = address_end + 1;
+		uint32_t mask = 0;
+		idx_t pos = digits_start;
+		while (pos < len && IsDigit(data[pos]) && pos - digits_start < 3) {
+			mask = mask * 10 + uint32_t(data[pos] - '0');
+			pos++;
+		}
+		if (pos == digits_start || pos != len || mask > result.mask) {
+			return false;
+		}
+		result.mask = uint16_t(mask);
+	}
+	return true;
+}
+
+bool ZeekInet::IsInetType(const LogicalType &type) {
+	return type.id() == LogicalTypeId::STRUCT && type.HasAlias() && type.GetAlias() == "INET";
+}
+
+bool ZeekInet::SupportsNativeDecoding(ClientContext &context, const LogicalType &type) {
+	if (!IsInetType(type)) {
+		return false;
+	}
+	auto &children = StructType::GetChildTypes(type);
+	if (children.size() != 3 || children[0].second.id() != LogicalTypeId::UTINYINT ||
+	    children[1].second.id() != LogicalTypeId::HUGEINT || children[2].second.id() != LogicalTypeId::USMALLINT) {
+		return false;
+	}
+
+	static const char *const PROBES[] = {"10.20.40.41",
+	                                     "0.0.0.0",
+	                                     "255.255.255.255",
+	                                     "192.168.0.0/16",
+	                                     "10.1.2.3/8",
+	                                     "::",
+	                                     "::1",
+	                                     "2001:db8::ff00:42:8329",
+	                                     "fe80::/10",
+	                                     "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff",
+	                                     "2001:db8:0:0:1::1/128",
+	                                     "::ffff:10.0.0.1"};
+	for (auto probe : PROBES) {
+		ZeekInetAddress parsed;
+		const bool parsed_ok = Parse(probe, strlen(probe), parsed);
+		Value cast_value;
+		bool cast_ok = true;
+		try {
+			cast_value = Value(probe).CastAs(context, type);
+		} catch (std::exception &) {
+			cast_ok = false;
+		}
+		if (parsed_ok != cast_ok) {
+			return false;
+		}
+		if (cast_ok && FromValue(cast_value) != parsed) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! The inet extension stores IPv6 addresses with the top bit flipped, so that comparing the signed
+//! HUGEINT orders them like unsigned 128-bit values.
+static hugeint_t ToStoredAddress(const ZeekInetAddress &address) {
+	hugeint_t result;
+	result.lower = address.lower;
+	result.upper = int64_t(address.ip_type == ZeekInet::IPV6 ? address.upper ^ IPV6_SIGN_FLIP : address.upper);
+	return result;
+}
+
+void ZeekInet::Write(Vector &vec, idx_t row_idx, const ZeekInetAddress &address) {
+	auto &entries = StructVector::GetEntries(vec);
+	FlatVector::GetData<uint8_t>(*entries[0])[row_idx] = address.ip_type;
+	FlatVector::GetData<hugeint_t>(*entries[1])[row_idx] = ToStoredAddress(address);
+	FlatVector::GetData<uint16_t>(*entries[2])[row_idx] = address.mask;
+}
+
+Value ZeekInet::ToValue(const LogicalType &type, const ZeekInetAddress &address) {
+	vector<Value> children;
+	children.push_back(Value::UTINYINT(address.ip_type));
+	children.push_back(Value::HUGEINT(ToStoredAddress(address)));
+	children.push_back(Value::USMALLINT(address.mask));
+	return Value::STRUCT(type, std::move(children));
+}
+
+ZeekInetAddress ZeekInet::FromValue(const Value &value) {
+	auto &children = StructValue::GetChildren(value);
+	ZeekInetAddress result;
+	result.ip_type = children[0].GetValue<uint8_t>();
+	auto stored = children[1].GetValue<hugeint_t>();
+	result.upper = uint64_t(stored.upper);
+	if (result.ip_type == IPV6) {
+		result.upper ^= IPV6_SIGN_FLIP;
+	}
+	result.lower = stored.lower;
+	result.mask = children[2].GetValue<uint16_t>();
+	return result;
+}
+
+//! Mask keeping the top `bits` bits of a `width`-bit word (bits <= width <= 64).
+static inline uint64_t PrefixMask(uint64_t bits, uint64_t width) {
+	if (bits == 0) {
+		return 0;
+	}
+	const uint64_t word_mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+	return (~uint64_t(0) << (width - bits)) & word_mask;
+}
+
+bool ZeekInet::Contains(const ZeekInetAddress &network, const ZeekInetAddress &address) {
+	if (network.ip_type != address.ip_type || network.mask > address.mask) {
+		return false;
+	}
+	if (network.ip_type == IPV4) {
+		const uint64_t mask = PrefixMask(network.mask, 32);
+		return (network.lower & mask) == (address.lower & mask);
+	}
+	const uint64_t upper_mask = PrefixMask(MinValue<uint64_t>(network.mask, 64), 64);
+	const uint64_t lower_mask = network.mask > 64 ? PrefixMask(network.mask - 64, 64) : 0;
+	return (network.upper & upper_mask) == (address.upper & upper_mask) &&
+	       (network.lower & lower_mask) == (address.lower & lower_mask);
+}
+
+} // namespace duckdb
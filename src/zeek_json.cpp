@@ -0,0 +1,557 @@
+#include "zeek_json.hpp"
+#include "zeek_inet.hpp"
+#include "zeek_reader.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace duckdb {
+
+ZeekJsonFieldMap::ZeekJsonFieldMap(vector<string> fields_p) : fields(std::move(fields_p)) {
+	for (idx_t i = 0; i < fields.size(); i++) {
+		lookup.emplace(string_t(fields[i].data(), UnsafeNumericCast<uint32_t>(fields[i].size())), i);
+	}
+}
+
+idx_t ZeekJsonFieldMap::Find(const char *key, idx_t len, idx_t guess) const {
+	if (guess < fields.size() && fields[guess].size() == len && std::memcmp(fields[guess].data(), key, len) == 0) {
+		return guess;
+	}
+	auto it = lookup.find(string_t(key, UnsafeNumericCast<uint32_t>(len)));
+	return it == lookup.end() ? DConstants::INVALID_INDEX : it->second;
+}
+
+static inline bool IsJsonSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline idx_t SkipSpace(const char *data, idx_t pos, idx_t len) {
+	while (pos < len && IsJsonSpace(data[pos])) {
+		pos++;
+	}
+	return pos;
+}
+
+//! Position past the closing quote of the string whose content starts at `pos`, or INVALID_INDEX if
+//! it is unterminated. Sets `escaped` if the string contains escape sequences.
+static idx_t FindStringEnd(const char *data, idx_t pos, idx_t len, bool &escaped) {
+	const idx_t content_start = pos;
+	while (pos < len) {
+		auto quote = static_cast<const char *>(std::memchr(data + pos, '"', len - pos));
+		if (!quote) {
+			return DConstants::INVALID_INDEX;
+		}
+		// The quote is escaped if an odd number of backslashes precede it. The byte before `pos` is
+		// never a backslash: it is the opening quote or a quote found before.
+		const idx_t quote_pos = static_cast<idx_t>(quote - data);
+		idx_t backslashes = 0;
+		while (quote_pos - backslashes > pos && data[quote_pos - backslashes - 1] == '\\') {
+			backslashes++;
+		}
+		if (backslashes % 2 == 0) {
+			escaped = std::memchr(data + content_start, '\\', quote_pos - content_start) != nullptr;
+			return quote_pos + 1;
+		}
+		pos = quote_pos + 1;
+	}
+	return DConstants::INVALID_INDEX;
+}
+
+//! End of the number, boolean or null starting at `pos`.
+static idx_t ScalarEnd(const char *data, idx_t pos, idx_t len) {
+	while (pos < len && data[pos] != ',' && data[pos] != '}' && data[pos] != ']' && !IsJsonSpace(data[pos])) {
+		pos++;
+	}
+	return pos;
+}
+
+//! End of the value starting at `pos`, or INVALID_INDEX if it is malformed.
+static idx_t SkipValue(const char *data, idx_t pos, idx_t len) {
+	bool escaped;
+	if (data[pos] == '"') {
+		return FindStringEnd(data, pos + 1, len, escaped);
+	}
+	if (data[pos] != '{' && data[pos] != '[') {
+		return ScalarEnd(data, pos, len);
+	}
+	idx_t depth = 0;
+	while (pos < len) {
+		const char c = data[pos];
+		if (c == '"') {
+			pos = FindStringEnd(data, pos + 1, len, escaped);
+			if (pos == DConstants::INVALID_INDEX) {
+				return pos;
+			}
+			continue;
+		}
+		if (c == '{' || c == '[') {
+			depth++;
+		} else if ((c == '}' || c == ']') && --depth == 0) {
+			return pos + 1;
+		}
+		pos++;
+	}
+	return DConstants::INVALID_INDEX;
+}
+
+static inline bool IsLiteral(const char *data, idx_t len, const char *literal) {
+	return len == std::strlen(literal) && std::memcmp(data, literal, len) == 0;
+}
+
+static bool ParseHex4(const char *data, idx_t len, uint32_t &result) {
+	if (len < 4) {
+		return false;
+	}
+	result = 0;
+	for (idx_t i = 0; i < 4; i++) {
+		const char c = data[i];
+		uint32_t digit;
+		if (c >= '0' && c <= '9') {
+			digit = uint32_t(c - '0');
+		} else if (c >= 'a' && c <= 'f') {
+			digit = uint32_t(c - 'a' + 10);
+		} else if (c >= 'A' && c <= 'F') {
+			digit = uint32_t(c - 'A' + 10);
+		} else {
+			return false;
+		}
+		result = result << 4 | digit;
+	}
+	return true;
+}
+
+static idx_t EncodeUtf8(uint32_t code_point, char *out) {
+	if (code_point < 0x80) {
+		out[0] = char(code_point);
+		return 1;
+	}
+	if (code_point < 0x800) {
+		out[0] = char(0xC0 | (code_point >> 6));
+		out[1] = char(0x80 | (code_point & 0x3F));
+		return 2;
+	}
+	if (code_point < 0x10000) {
+		out[0] = char(0xE0 | (code_point >> 12));
+		out[1] = char(0x80 | ((code_point >> 6) & 0x3F));
+		out[2] = char(0x80 | (code_point & 0x3F));
+		return 3;
+	}
+	out[0] = char(0xF0 | (code_point >> 18));
+	out[1] = char(0x80 | ((code_point >> 12) & 0x3F));
+	out[2] = char(0x80 | ((code_point >> 6) & 0x3F));
+	out[3] = char(0x80 | (code_point & 0x3F));
+	return 4;
+}
+
+//! Write the string content data[0, len) to `out` with its escape sequences decoded, and return the
+//! number of bytes written, which is at most `len`. Unknown escapes are kept as written.
+static idx_t Unescape(const char *data, idx_t len, char *out) {
+	idx_t written = 0;
+	for (idx_t i = 0; i < len; i++) {
+		if (data[i] != '\\' || i + 1 == len) {
+			out[written++] = data[i];
+			continue;
+		}
+		const char escape = data[++i];
+		switch (escape) {
+		case '"':
+		case '\\':
+		case '/':
+			out[written++] = escape;
+			break;
+		case 'b':
+			out[written++] = '\b';
+			break;
+		case 'f':
+			out[written++] = '\f';
+			break;
+		case 'n':
+			out[written++] = '\n';
+			break;
+		case 'r':
+			out[written++] = '\r';
+			break;
+		case 't':
+			out[written++] = '\t';
+			break;
+		case 'u': {
+			uint32_t code_point;
+			if (!ParseHex4(data + i + 1, len - i - 1, code_point)) {
+				out[written++] = '\\';
+				out[written++] = escape;
+				break;
+			}
+			i += 4;
+			if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+				// A surrogate pair encodes one code point; a lone surrogate becomes U+FFFD.
+				uint32_t low;
+				if (code_point <= 0xDBFF && i + 2 < len && data[i + 1] == '\\' && data[i + 2] == 'u' &&
+				    ParseHex4(data + i + 3, len - i - 3, low) && low >= 0xDC00 && low <= 0xDFFF) {
+					code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+					i += 6;
+				} else {
+					code_point = 0xFFFD;
+				}
+			}
+			written += EncodeUtf8(code_point, out + written);
+			break;
+		}
+		default:
+			out[written++] = '\\';
+			out[written++] = escape;
+			break;
+		}
+	}
+	return written;
+}
+
+//! Call `on_member(key, key_len, value_pos)` for each member of the object in data[0, len), in
+//! order. The callback returns the end of the value, or INVALID_INDEX to stop; iteration also stops
+//! at the first syntax error.
+template <class ON_MEMBER>
+static void ForEachMember(const char *data, idx_t len, ON_MEMBER &&on_member) {
+	idx_t pos = SkipSpace(data, 0, len);
+	if (pos >= len || data[pos] != '{') {
+		return;
+	}
+	pos = SkipSpace(data, pos + 1, len);
+	while (pos < len && data[pos] == '"') {
+		bool escaped;
+		const idx_t key_end = FindStringEnd(data, pos + 1, len, escaped);
+		if (key_end == DConstants::INVALID_INDEX) {
+			return;
+		}
+		const char *key = data + pos + 1;
+		const idx_t key_len = key_end - pos - 2;
+		pos = SkipSpace(data, key_end, len);
+		if (pos >= len || data[pos] != ':') {
+			return;
+		}
+		pos = SkipSpace(data, pos + 1, len);
+		if (pos >= len) {
+			return;
+		}
+		pos = on_member(key, key_len, pos);
+		if (pos == DConstants::INVALID_INDEX) {
+			return;
+		}
+		pos = SkipSpace(data, pos, len);
+		if (pos >= len || data[pos] != ',') {
+			return;
+		}
+		pos = SkipSpace(data, pos + 1, len);
+	}
+}
+
+bool ZeekJson::IsJsonLine(const char *line, idx_t len) {
+	const idx_t pos = SkipSpace(line, 0, len);
+	return pos < len && line[pos] == '{';
+}
+
+namespace {
+
+//! What the sampled values of one field (or of the elements of its arrays) looked like.
+struct JsonFieldStats {
+	idx_t strings = 0;
+	idx_t addresses = 0;
+	idx_t subnets = 0;
+	idx_t numbers = 0;
+	bool fractional = false;
+	bool negative = false;
+	bool above_port_range = false;
+	idx_t booleans = 0;
+	idx_t arrays = 0;
+	idx_t objects = 0;
+	unique_ptr<JsonFieldStats> elements;
+};
+
+} // namespace
+
+//! Record the value starting at `pos` in `stats`, and return its end (or INVALID_INDEX).
+static idx_t AddSampleValue(JsonFieldStats &stats, const char *data, idx_t pos, idx_t len) {
+	const char c = data[pos];
+	if (c == '"') {
+		bool escaped;
+		const idx_t end = FindStringEnd(data, pos + 1, len, escaped);
+		if (end == DConstants::INVALID_INDEX) {
+			return end;
+		}
+		stats.strings++;
+		ZeekInetAddress address;
+		const char *content = data + pos + 1;
+		const idx_t content_len = end - pos - 2;
+		if (!escaped && ZeekInet::Parse(content, content_len, address)) {
+			if (std::memchr(content, '/', content_len)) {
+				stats.subnets++;
+			} else {
+				stats.addresses++;
+			}
+		}
+		return end;
+	}
+	if (c == '[') {
+		stats.arrays++;
+		if (!stats.elements) {
+			stats.elements = make_uniq<JsonFieldStats>();
+		}
+		pos = SkipSpace(data, pos + 1, len);
+		if (pos < len && data[pos] == ']') {
+			return pos + 1;
+		}
+		while (pos < len) {
+			pos = AddSampleValue(*stats.elements, data, pos, len);
+			if (pos == DConstants::INVALID_INDEX) {
+				return pos;
+			}
+			pos = SkipSpace(data, pos, len);
+			if (pos < len && data[pos] == ']') {
+				return pos + 1;
+			}
+			if (pos >= len || data[pos] != ',') {
+				return DConstants::INVALID_INDEX;
+			}
+			pos = SkipSpace(data, pos + 1, len);
+		}
+		return DConstants::INVALID_INDEX;
+	}
+	if (c == '{') {
+		stats.objects++;
+		return SkipValue(data, pos, len);
+	}
+	const idx_t end = ScalarEnd(data, pos, len);
+	if (IsLiteral(data + pos, end - pos, "null")) {
+		return end;
+	}
+	if (IsLiteral(data + pos, end - pos, "true") || IsLiteral(data + pos, end - pos, "false")) {
+		stats.booleans++;
+		return end;
+	}
+	stats.numbers++;
+	uint64_t value = 0;
+	for (idx_t i = pos; i < end; i++) {
+		const char digit = data[i];
+		if (digit == '-') {
+			stats.negative = true;
+		} else if (digit == '.' || digit == 'e' || digit == 'E') {
+			stats.fractional = true;
+		} else if (value <= 65535) {
+			value = value * 10 + uint64_t(digit - '0');
+		}
+	}
+	stats.above_port_range = stats.above_port_range || value > 65535;
+	return end;
+}
+
+//! Numeric fields that Zeek logs as intervals.
+static bool IsIntervalField(const string &name) {
+	return StringUtil::EndsWith(name, "duration") || name == "rtt" || StringUtil::EndsWith(name, "_rtt") ||
+	       name == "lease_time" || name == "TTLs";
+}
+
+static string InferZeekType(const JsonFieldStats &stats, const string &name) {
+	const idx_t kinds = (stats.strings > 0) + (stats.numbers > 0) + (stats.booleans > 0) + (stats.arrays > 0) +
+	                    (stats.objects > 0);
+	if (kinds != 1 || stats.objects > 0) {
+		return "string";
+	}
+	if (stats.arrays > 0) {
+		return "vector[" + (stats.elements ? InferZeekType(*stats.elements, name) : string("string")) + "]";
+	}
+	if (stats.booleans > 0) {
+		return "bool";
+	}
+	if (stats.strings > 0) {
+		if (stats.addresses == stats.strings) {
+			return "addr";
+		}
+		if (stats.subnets == stats.strings) {
+			return "subnet";
+		}
+		return "string";
+	}
+	if (name == "ts") {
+		return "time";
+	}
+	if (IsIntervalField(name)) {
+		return "interval";
+	}
+	if (!stats.fractional && !stats.negative && !stats.above_port_range && StringUtil::EndsWith(name, "_p")) {
+		return "port";
+	}
+	if (stats.fractional) {
+		return "double";
+	}
+	return stats.negative ? "int" : "count";
+}
+
+void ZeekJson::InferHeader(const char *data, idx_t size, ZeekHeader &header) {
+	vector<string> order;
+	std::unordered_map<string, JsonFieldStats> stats;
+	idx_t pos = 0;
+	idx_t lines = 0;
+	while (pos < size && lines < SAMPLE_LINES) {
+		auto newline = static_cast<const char *>(std::memchr(data + pos, '\n', size - pos));
+		if (!newline) {
+			break;
+		}
+		const char *line = data + pos;
+		const idx_t len = static_cast<idx_t>(newline - line);
+		pos += len + 1;
+		if (len == 0 || line[0] == '#') {
+			continue;
+		}
+		lines++;
+		// A field first seen in a later line (Zeek leaves unset fields out) goes after the key before
+		// it, so that fields keep the order Zeek writes them in.
+		idx_t insert_pos = 0;
+		ForEachMember(line, len, [&](const char *key, idx_t key_len, idx_t value_pos) {
+			string name(key, key_len);
+			auto it = stats.find(name);
+			if (it == stats.end()) {
+				it = stats.emplace(name, JsonFieldStats()).first;
+				order.insert(order.begin() + static_cast<std::ptrdiff_t>(insert_pos), name);
+			}
+			insert_pos = static_cast<idx_t>(std::find(order.begin(), order.end(), name) - order.begin()) + 1;
+			return AddSampleValue(it->second, line, value_pos, len);
+		});
+	}
+	header.json = true;
+	header.fields = order;
+	header.types.clear();
+	for (auto &name : order) {
+		header.types.push_back(InferZeekType(stats[name], name));
+	}
+}
+
+static const char JSON_UNSET_MARKER = '\xFF';
+static const char JSON_EMPTY_MARKER = '\xFE';
+//! U+FFFD, in place of a string that is a lone marker byte.
+static const char REPLACEMENT_CHARACTER[] = "\xEF\xBF\xBD";
+
+static ZeekHeader MakeMarkers() {
+	ZeekHeader markers;
+	markers.json = true;
+	markers.unset_field = string(1, JSON_UNSET_MARKER);
+	markers.empty_field = string(1, JSON_EMPTY_MARKER);
+	return markers;
+}
+
+const ZeekHeader &ZeekJson::Markers() {
+	static const ZeekHeader markers = MakeMarkers();
+	return markers;
+}
+
+//! True if the value data[0, len) is a lone marker byte.
+static inline bool IsMarkerValue(const char *data, idx_t len) {
+	return len == 1 && (data[0] == JSON_UNSET_MARKER || data[0] == JSON_EMPTY_MARKER);
+}
+
+bool ZeekJson::TokenizeLine(const char *line, idx_t len, const ZeekJsonFieldMap &fields, vector<FieldSlice> &slices,
+                            vector<char> &scratch) {
+	const auto &markers = Markers();
+	const FieldSlice unset {markers.unset_field.data(), 1};
+	const FieldSlice empty {markers.empty_field.data(), 1};
+	slices.assign(fields.FieldCount(), unset);
+	// Unescaping and joining never grow a value: a null array element becomes a one-byte marker, and a
+	// lone marker byte in a string its three-byte replacement, which is as long as the quoted byte.
+	if (scratch.size() < len) {
+		scratch.resize(len);
+	}
+	char *out = scratch.data();
+	idx_t used = 0;
+	idx_t guess = 0;
+
+	// Write the string whose content starts at `pos` to the scratch buffer, returning its end.
+	auto append_string = [&](idx_t pos) {
+		bool escaped;
+		const idx_t end = FindStringEnd(line, pos + 1, len, escaped);
+		if (end != DConstants::INVALID_INDEX) {
+			const idx_t start = used;
+			used += Unescape(line + pos + 1, end - pos - 2, out + used);
+			if (IsMarkerValue(out + start, used - start)) {
+				std::memcpy(out + start, REPLACEMENT_CHARACTER, 3);
+				used = start + 3;
+			}
+		}
+		return end;
+	};
+
+	ForEachMember(line, len, [&](const char *key, idx_t key_len, idx_t pos) -> idx_t {
+		const idx_t field_idx = fields.Find(key, key_len, guess);
+		if (field_idx == DConstants::INVALID_INDEX) {
+			return SkipValue(line, pos, len);
+		}
+		guess = field_idx + 1;
+		auto &slice = slices[field_idx];
+		const char c = line[pos];
+		if (c == '"') {
+			bool escaped;
+			const idx_t end = FindStringEnd(line, pos + 1, len, escaped);
+			if (end == DConstants::INVALID_INDEX) {
+				return end;
+			}
+			if (!escaped) {
+				slice = {line + pos + 1, static_cast<uint32_t>(end - pos - 2)};
+			} else {
+				const idx_t start = used;
+				used += Unescape(line + pos + 1, end - pos - 2, out + used);
+				slice = {out + start, static_cast<uint32_t>(used - start)};
+			}
+			if (IsMarkerValue(slice.ptr, slice.len)) {
+				slice = {REPLACEMENT_CHARACTER, 3};
+			}
+			return end;
+		}
+		if (c == '[') {
+			const idx_t start = used;
+			idx_t count = 0;
+			pos = SkipSpace(line, pos + 1, len);
+			while (pos < len && line[pos] != ']') {
+				if (count > 0) {
+					if (line[pos] != ',') {
+						return DConstants::INVALID_INDEX;
+					}
+					pos = SkipSpace(line, pos + 1, len);
+					if (pos >= len) {
+						return DConstants::INVALID_INDEX;
+					}
+					out[used++] = LIST_SEPARATOR;
+				}
+				idx_t end;
+				if (line[pos] == '"') {
+					end = append_string(pos);
+				} else {
+					end = SkipValue(line, pos, len);
+					if (end != DConstants::INVALID_INDEX) {
+						if (IsLiteral(line + pos, end - pos, "null")) {
+							out[used++] = JSON_UNSET_MARKER;
+						} else {
+							std::memcpy(out + used, line + pos, end - pos);
+							used += end - pos;
+						}
+					}
+				}
+				if (end == DConstants::INVALID_INDEX) {
+					return end;
+				}
+				count++;
+				pos = SkipSpace(line, end, len);
+			}
+			if (pos >= len) {
+				return DConstants::INVALID_INDEX;
+			}
+			slice = count == 0 ? empty : FieldSlice {out + start, static_cast<uint32_t>(used - start)};
+			return pos + 1;
+		}
+		const idx_t end = SkipValue(line, pos, len);
+		if (end != DConstants::INVALID_INDEX && !IsLiteral(line + pos, end - pos, "null")) {
+			slice = {line + pos, static_cast<uint32_t>(end - pos)};
+		}
+		return end;
+	});
+	return used > 0;
+}
+
+} // namespace duckdb
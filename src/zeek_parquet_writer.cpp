@@ -0,0 +1,201 @@
+#include "zeek_parquet_writer.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/copy_function_catalog_entry.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/main/extension_helper.hpp"
+#include "duckdb/parser/parsed_data/copy_info.hpp"
+
+namespace duckdb {
+
+//! The parquet extension's COPY function, loading the extension if it isn't loaded yet.
+static const CopyFunction &GetParquetCopyFunction(ClientContext &context) {
+	ExtensionHelper::TryAutoLoadExtension(context, "parquet");
+	auto entry = Catalog::GetEntry<CopyFunctionCatalogEntry>(context, INVALID_CATALOG, DEFAULT_SCHEMA, "parquet",
+	                                                         OnEntryNotFound::RETURN_NULL);
+	if (!entry) {
+		throw InvalidInputException("read_zeek: writing Parquet files requires the parquet extension");
+	}
+	return entry->function;
+}
+
+ZeekParquetWriter::ZeekParquetWriter(ClientContext &context_p, vector<ZeekParquetFileSpec> specs,
+                                     const string &compression, const string &source_column)
+    : context(context_p), copy_function(GetParquetCopyFunction(context_p)), source_column(source_column) {
+	CopyInfo info;
+	info.format = "parquet";
+	info.options["compression"].push_back(Value(compression));
+	for (auto &spec : specs) {
+		auto file = make_uniq<File>();
+		file->file_idx = files.size();
+		if (!spec.path.empty()) {
+			vector<string> names = spec.names;
+			file->types = spec.types;
+			if (!source_column.empty()) {
+				names.push_back(source_column);
+				file->types.push_back(LogicalType::VARCHAR);
+			}
+			CopyFunctionBindInput bind_input(info);
+			file->bind_data = copy_function.copy_to_bind(context, bind_input, names, file->types);
+			file->temp_path = spec.path + "." + UUID::ToString(UUID::GenerateRandomUUID()) + ".tmp";
+			file->units_left = spec.unit_count;
+		}
+		file->spec = std::move(spec);
+		files.push_back(std::move(file));
+	}
+}
+
+ZeekParquetWriter::~ZeekParquetWriter() {
+	for (auto &file : files) {
+		try {
+			Discard(*file);
+		} catch (...) {
+			// Best effort: a temporary file left behind is never read.
+		}
+	}
+}
+
+void ZeekParquetWriter::Discard(File &file) {
+	file.global_state.reset();
+	if (file.opened) {
+		auto &fs = FileSystem::GetFileSystem(context);
+		if (fs.FileExists(file.temp_path)) {
+			fs.RemoveFile(file.temp_path);
+		}
+		file.opened = false;
+	}
+}
+
+void ZeekParquetWriter::BeginUnit(ExecutionContext &exec_context, idx_t file_idx, UnitState &unit) {
+	auto &file = *files[file_idx];
+	unit.file_idx = DConstants::INVALID_INDEX;
+	unit.local_state.reset();
+	unit.rows = 0;
+	unit.has_ts = false;
+	if (file.spec.path.empty()) {
+		return;
+	}
+	unit.file_idx = file_idx;
+	{
+		std::lock_guard<std::mutex> guard(file.lock);
+		if (file.abandoned) {
+			// The file is discarded anyway; the unit is only counted.
+			return;
+		}
+		if (!file.global_state) {
+			file.opened = true;
+			file.global_state = copy_function.copy_to_initialize_global(context, *file.bind_data, file.temp_path);
+		}
+	}
+	unit.local_state = copy_function.copy_to_initialize_local(exec_context, *file.bind_data);
+	unit.chunk.Destroy();
+	unit.chunk.InitializeEmpty(file.types);
+}
+
+void ZeekParquetWriter::Write(ExecutionContext &exec_context, UnitState &unit, DataChunk &chunk) {
+	if (!unit.local_state || chunk.size() == 0) {
+		return;
+	}
+	auto &file = *files[unit.file_idx];
+	auto &column_ids = file.spec.column_ids;
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		unit.chunk.data[i].Reference(chunk.data[column_ids[i]]);
+	}
+	if (!source_column.empty()) {
+		unit.chunk.data[column_ids.size()].Reference(Value(file.spec.source_value));
+	}
+	unit.chunk.SetCardinality(chunk.size());
+
+	if (file.spec.ts_column != DConstants::INVALID_INDEX) {
+		UnifiedVectorFormat format;
+		unit.chunk.data[file.spec.ts_column].ToUnifiedFormat(chunk.size(), format);
+		auto values = UnifiedVectorFormat::GetData<timestamp_tz_t>(format);
+		for (idx_t r = 0; r < chunk.size(); r++) {
+			const idx_t idx = format.sel->get_index(r);
+			if (!format.validity.RowIsValid(idx)) {
+				continue;
+			}
+			if (!unit.has_ts || values[idx] < unit.min_ts) {
+				unit.min_ts = values[idx];
+			}
+			if (!unit.has_ts || values[idx] > unit.max_ts) {
+				unit.max_ts = values[idx];
+			}
+			unit.has_ts = true;
+		}
+	}
+
+	copy_function.copy_to_sink(exec_context, *file.bind_data, *file.global_state, *unit.local_state, unit.chunk);
+	unit.rows += chunk.size();
+}
+
+void ZeekParquetWriter::EndUnit(ExecutionContext &exec_context, UnitState &unit) {
+	if (unit.file_idx == DConstants::INVALID_INDEX) {
+		return;
+	}
+	auto &file = *files[unit.file_idx];
+	unit.file_idx = DConstants::INVALID_INDEX;
+	if (unit.local_state) {
+		copy_function.copy_to_combine(exec_context, *file.bind_data, *file.global_state, *unit.local_state);
+		unit.local_state.reset();
+	}
+	std::lock_guard<std::mutex> guard(file.lock);
+	file.rows += unit.rows;
+	if (unit.has_ts) {
+		if (!file.has_ts || unit.min_ts < file.min_ts) {
+			file.min_ts = unit.min_ts;
+		}
+		if (!file.has_ts || unit.max_ts > file.max_ts) {
+			file.max_ts = unit.max_ts;
+		}
+		file.has_ts = true;
+	}
+	EndFileUnit(file, false);
+}
+
+void ZeekParquetWriter::AbandonUnit(idx_t file_idx) {
+	auto &file = *files[file_idx];
+	if (file.spec.path.empty()) {
+		return;
+	}
+	std::lock_guard<std::mutex> guard(file.lock);
+	EndFileUnit(file, true);
+}
+
+void ZeekParquetWriter::EndFileUnit(File &file, bool abandoned) {
+	file.abandoned = file.abandoned || abandoned;
+	if (--file.units_left > 0) {
+		return;
+	}
+	if (file.abandoned) {
+		Discard(file);
+		return;
+	}
+	copy_function.copy_to_finalize(context, *file.bind_data, *file.global_state);
+	file.global_state.reset();
+	auto &fs = FileSystem::GetFileSystem(context);
+	fs.MoveFile(file.temp_path, file.spec.path);
+	file.opened = false;
+
+	ZeekWrittenParquet written;
+	written.file_idx = file.file_idx;
+	written.rows = file.rows;
+	if (file.has_ts) {
+		written.min_ts = Value::TIMESTAMPTZ(file.min_ts);
+		written.max_ts = Value::TIMESTAMPTZ(file.max_ts);
+	}
+	written.bytes = fs.GetFileSize(*fs.OpenFile(file.spec.path, FileFlags::FILE_FLAGS_READ));
+	std::lock_guard<std::mutex> guard(written_lock);
+	written_files.push_back(std::move(written));
+}
+
+bool ZeekParquetWriter::NextWritten(ZeekWrittenParquet &written) {
+	std::lock_guard<std::mutex> guard(written_lock);
+	if (written_files.empty()) {
+		return false;
+	}
+	written = std::move(written_files.back());
+	written_files.pop_back();
+	return true;
+}
+
+} // namespace duckdb
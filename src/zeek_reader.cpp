@@ -1,9 +1,18 @@
 #include "zeek_reader.hpp"
+#include "zeek_json.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/types.hpp"
+#include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/time.hpp"
+
+#include <cstring>
 
 namespace duckdb {
 
+//! Chunk size for reading headers.
+static constexpr idx_t HEADER_READ_SIZE = 4096;
+
 string ZeekReader::ParseSeparator(const string &sep_str) {
 	string result;
 	for (size_t i = 0; i < sep_str.size(); i++) {
@@ -30,23 +39,6 @@ string ZeekReader::ParseSeparator(const string &sep_str) {
 	return result;
 }
 
-bool ZeekReader::ReadLine(FileHandle &file_handle, string &line) {
-	line.clear();
-	char c;
-	while (true) {
-		int64_t bytes_read = file_handle.Read(&c, 1);
-		if (bytes_read == 0) {
-			return !line.empty();
-		}
-		if (c == '\n') {
-			return true;
-		}
-		if (c != '\r') {
-			line += c;
-		}
-	}
-}
-
 bool ZeekReader::ApplyHeaderLine(const char *line, idx_t len, ZeekHeader &header) {
 	if (len == 0 || line[0] != '#') {
 		return false;
@@ -92,18 +84,87 @@ bool ZeekReader::ApplyHeaderLine(const char *line, idx_t len, ZeekHeader &header
 
 ZeekHeader ZeekReader::ParseHeader(FileHandle &file_handle) {
 	ZeekHeader header;
-	string line;
+	// Headers are a few hundred bytes: read in small chunks, which costs one call into a
+	// (decompressing) file handle per chunk rather than per byte.
+	vector<char> buffer;
+	idx_t line_start = 0;
 	idx_t line_count = 0;
+	bool eof = false;
 
-	while (ReadLine(file_handle, line)) {
+	while (true) {
+		const char *data = buffer.data();
+		const char *newline =
+		    line_start < buffer.size()
+		        ? static_cast<const char *>(std::memchr(data + line_start, '\n', buffer.size() - line_start))
+		        : nullptr;
+		if (!newline && !eof) {
+			buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(line_start));
+			line_start = 0;
+			const idx_t old_size = buffer.size();
+			buffer.resize(old_size + HEADER_READ_SIZE);
+			const auto bytes_read = file_handle.Read(buffer.data() + old_size, HEADER_READ_SIZE);
+			buffer.resize(old_size + static_cast<idx_t>(bytes_read));
+			eof = bytes_read == 0;
+			continue;
+		}
+		const idx_t line_end = newline ? static_cast<idx_t>(newline - data) : buffer.size();
+		if (!newline && line_end == line_start) {
+			break;
+		}
+		idx_t line_len = line_end - line_start;
+		if (line_len > 0 && data[line_start + line_len - 1] == '\r') {
+			line_len--;
+		}
 		line_count++;
-		if (!ApplyHeaderLine(line.data(), line.size(), header)) {
+		if (!ApplyHeaderLine(data + line_start, line_len, header) || !newline) {
 			break;
 		}
+		line_start = line_end + 1;
 	}
 
 	header.header_line_count = line_count - 1;
 
+	// A JSON log has no header to parse: infer one from a larger sample of its lines.
+	if (header.fields.empty() && line_start < buffer.size() &&
+	    ZeekJson::IsJsonLine(buffer.data() + line_start, buffer.size() - line_start)) {
+		while (!eof && buffer.size() - line_start < ZeekJson::SAMPLE_SIZE) {
+			const idx_t old_size = buffer.size();
+			const idx_t wanted = ZeekJson::SAMPLE_SIZE - (old_size - line_start);
+			buffer.resize(old_size + wanted);
+			const auto bytes_read = file_handle.Read(buffer.data() + old_size, wanted);
+			buffer.resize(old_size + static_cast<idx_t>(bytes_read));
+			eof = bytes_read == 0;
+		}
+		if (eof && buffer.back() != '\n') {
+			buffer.push_back('\n');
+		}
+		ZeekJson::InferHeader(buffer.data() + line_start, buffer.size() - line_start, header);
+		if (header.fields.empty()) {
+			throw InvalidInputException("Zeek JSON log has no fields in its first lines");
+		}
+	}
+
+	// Sample the length of the data lines that follow, reading one more chunk if not even one of them
+	// is complete yet.
+	if (!eof && (line_start >= buffer.size() ||
+	             !std::memchr(buffer.data() + line_start, '\n', buffer.size() - line_start))) {
+		const idx_t old_size = buffer.size();
+		buffer.resize(old_size + HEADER_READ_SIZE);
+		const auto bytes_read = file_handle.Read(buffer.data() + old_size, HEADER_READ_SIZE);
+		buffer.resize(old_size + static_cast<idx_t>(bytes_read));
+	}
+	idx_t sample_lines = 0;
+	idx_t sample_end = line_start;
+	for (idx_t i = line_start; i < buffer.size(); i++) {
+		if (buffer[i] == '\n') {
+			sample_lines++;
+			sample_end = i + 1;
+		}
+	}
+	if (sample_lines > 0) {
+		header.sample_line_length = double(sample_end - line_start) / double(sample_lines);
+	}
+
 	if (header.fields.empty()) {
 		throw InvalidInputException("Zeek log file missing #fields directive");
 	}
@@ -162,7 +223,82 @@ LogicalType ZeekReader::ZeekTypeToDuckDBType(const string &zeek_type, bool use_i
 	return LogicalType::VARCHAR;
 }
 
+//! Parse `count` decimal digits at `str[pos]`. Returns false if any of them isn't a digit.
+static bool ParseFixedDigits(const string &str, idx_t pos, idx_t count, int32_t &result) {
+	result = 0;
+	for (idx_t i = pos; i < pos + count; i++) {
+		if (str[i] < '0' || str[i] > '9') {
+			return false;
+		}
+		result = result * 10 + (str[i] - '0');
+	}
+	return true;
+}
+
+//! Parse "HH.MM.SS" at `str[pos]`.
+static bool ParseRotationTime(const string &str, idx_t pos, dtime_t &result) {
+	int32_t hour, minute, second;
+	if (!ParseFixedDigits(str, pos, 2, hour) || str[pos + 2] != '.' || !ParseFixedDigits(str, pos + 3, 2, minute) ||
+	    str[pos + 5] != '.' || !ParseFixedDigits(str, pos + 6, 2, second)) {
+		return false;
+	}
+	if (!Time::IsValidTime(hour, minute, second, 0)) {
+		return false;
+	}
+	result = Time::FromTime(hour, minute, second);
+	return true;
+}
+
+//! Parse "_YYYYMMDD_HH.MM.SS-HH.MM.SS+HHMM" at `str[pos]`.
+static bool ParseRotationSuffix(const string &str, idx_t pos, timestamp_tz_t &start, timestamp_tz_t &end) {
+	int32_t year, month, day, offset_hours, offset_minutes;
+	dtime_t start_time, end_time;
+	if (str[pos] != '_' || !ParseFixedDigits(str, pos + 1, 4, year) || !ParseFixedDigits(str, pos + 5, 2, month) ||
+	    !ParseFixedDigits(str, pos + 7, 2, day) || str[pos + 9] != '_' ||
+	    !ParseRotationTime(str, pos + 10, start_time) || str[pos + 18] != '-' ||
+	    !ParseRotationTime(str, pos + 19, end_time) || (str[pos + 27] != '+' && str[pos + 27] != '-') ||
+	    !ParseFixedDigits(str, pos + 28, 2, offset_hours) || !ParseFixedDigits(str, pos + 30, 2, offset_minutes)) {
+		return false;
+	}
+	if (!Date::IsValid(year, month, day)) {
+		return false;
+	}
+	const date_t date = Date::FromDate(year, month, day);
+	const int64_t offset_micros =
+	    (str[pos + 27] == '-' ? -1 : 1) * (offset_hours * 60 + offset_minutes) * Interval::MICROS_PER_MINUTE;
+	const int64_t start_micros = Timestamp::FromDatetime(date, start_time).value - offset_micros;
+	int64_t end_micros = Timestamp::FromDatetime(date, end_time).value - offset_micros;
+	if (end_micros <= start_micros) {
+		// The interval crosses midnight (e.g. 23.00.00-00.00.00).
+		end_micros += Interval::MICROS_PER_DAY;
+	}
+	start = timestamp_tz_t(start_micros);
+	end = timestamp_tz_t(end_micros);
+	return true;
+}
+
+bool ZeekReader::ParseRotationInterval(const string &path, timestamp_tz_t &start, timestamp_tz_t &end) {
+	static constexpr idx_t SUFFIX_LENGTH = 32;
+	auto name_start = path.find_last_of("/\\");
+	name_start = name_start == string::npos ? 0 : name_start + 1;
+	if (path.size() < name_start + SUFFIX_LENGTH) {
+		return false;
+	}
+	// Take the last match, in case the log stream's own name contains digits and underscores.
+	for (idx_t pos = path.size() - SUFFIX_LENGTH + 1; pos-- > name_start;) {
+		if (ParseRotationSuffix(path, pos, start, end)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool SameSchema(const ZeekHeader &expected, const ZeekHeader &actual, string &mismatch_reason) {
+	if (expected.json != actual.json) {
+		mismatch_reason =
+		    expected.json ? "format differs: expected JSON, got TSV" : "format differs: expected TSV, got JSON";
+		return false;
+	}
 	if (expected.fields.size() != actual.fields.size()) {
 		mismatch_reason =
 		    StringUtil::Format("different field count: expected %llu fields, got %llu",
@@ -204,4 +340,23 @@ bool SameSchema(const ZeekHeader &expected, const ZeekHeader &actual, string &mi
 	return true;
 }
 
+bool ZeekReader::IsCompressedPath(const string &path) {
+	auto lower_path = StringUtil::Lower(path);
+	return StringUtil::EndsWith(lower_path, ".gz") || StringUtil::EndsWith(lower_path, ".zst");
+}
+
+bool ZeekReader::TryCastMicros(const char *data, idx_t len, int64_t &micros) {
+	double seconds;
+	if (!TryCast::Operation<string_t, double>(string_t(data, len), seconds)) {
+		return false;
+	}
+	double scaled = seconds * static_cast<double>(Interval::MICROS_PER_SEC);
+	// Also rejects NaN
+	if (!(scaled > -9.2e18 && scaled < 9.2e18)) {
+		return false;
+	}
+	micros = static_cast<int64_t>(scaled);
+	return true;
+}
+
 } // namespace duckdb
@@ -0,0 +1,128 @@
+#include "zeek_scan_stats.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+void ZeekScanCounters::Add(const ZeekScanCounters &other) {
+	scan_units += other.scan_units;
+	files_skipped += other.files_skipped;
+	compressed_bytes += other.compressed_bytes;
+	decompressed_bytes += other.decompressed_bytes;
+	lines_read += other.lines_read;
+	comment_lines += other.comment_lines;
+	rows_filtered += other.rows_filtered;
+	rows_emitted += other.rows_emitted;
+	read_ns += other.read_ns;
+	tokenize_ns += other.tokenize_ns;
+	filter_ns += other.filter_ns;
+	convert_ns += other.convert_ns;
+	cast_ns += other.cast_ns;
+}
+
+void ZeekScanStats::Add(const ZeekScanCounters &counters) {
+	std::lock_guard<std::mutex> guard(lock);
+	totals.Add(counters);
+}
+
+ZeekScanCounters ZeekScanStats::Totals() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return totals;
+}
+
+ZeekScanStatsRegistry &ZeekScanStatsRegistry::Get(ClientContext &context) {
+	return *context.registered_state->GetOrCreate<ZeekScanStatsRegistry>("zeek_scan_stats");
+}
+
+void ZeekScanStatsRegistry::QueryBegin(ClientContext &context) {
+	std::lock_guard<std::mutex> guard(lock);
+	query++;
+}
+
+shared_ptr<ZeekScanStats> ZeekScanStatsRegistry::BeginScan(const string &pattern) {
+	std::lock_guard<std::mutex> guard(lock);
+	// The first scan of a query replaces those of the previous query that scanned; queries without
+	// read_zeek (such as the one calling zeek_scan_stats) leave them in place.
+	if (scans_query != query) {
+		scans.clear();
+		scans_query = query;
+	}
+	auto stats = make_shared_ptr<ZeekScanStats>(pattern);
+	scans.push_back(stats);
+	return stats;
+}
+
+vector<shared_ptr<ZeekScanStats>> ZeekScanStatsRegistry::Scans() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return scans;
+}
+
+struct ZeekScanStatsBindData : public TableFunctionData {
+	vector<string> patterns;
+	vector<ZeekScanCounters> totals;
+};
+
+struct ZeekScanStatsGlobalState : public GlobalTableFunctionState {
+	idx_t next_scan_idx = 0;
+};
+
+static unique_ptr<FunctionData> ZeekScanStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                  vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<ZeekScanStatsBindData>();
+	for (auto &stats : ZeekScanStatsRegistry::Get(context).Scans()) {
+		result->patterns.push_back(stats->pattern);
+		result->totals.push_back(stats->Totals());
+	}
+
+	names.push_back("scan");
+	return_types.push_back(LogicalType::UBIGINT);
+	names.push_back("pattern");
+	return_types.push_back(LogicalType::VARCHAR);
+	for (auto name : {"scan_units", "files_skipped", "compressed_bytes", "decompressed_bytes", "lines_read",
+	                  "comment_lines", "rows_filtered", "rows_emitted"}) {
+		names.push_back(name);
+		return_types.push_back(LogicalType::UBIGINT);
+	}
+	for (auto name : {"read_seconds", "tokenize_seconds", "filter_seconds", "convert_seconds", "cast_seconds"}) {
+		names.push_back(name);
+		return_types.push_back(LogicalType::DOUBLE);
+	}
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> ZeekScanStatsInitGlobal(ClientContext &context,
+                                                                    TableFunctionInitInput &input) {
+	return make_uniq<ZeekScanStatsGlobalState>();
+}
+
+static Value Seconds(uint64_t ns) {
+	return Value::DOUBLE(double(ns) / 1e9);
+}
+
+//! One row per read_zeek scan of the most recent query that had any.
+static void ZeekScanStatsExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<ZeekScanStatsBindData>();
+	auto &gstate = data.global_state->Cast<ZeekScanStatsGlobalState>();
+	idx_t row = 0;
+	while (gstate.next_scan_idx < bind_data.totals.size() && row < STANDARD_VECTOR_SIZE) {
+		const idx_t scan_idx = gstate.next_scan_idx++;
+		auto &totals = bind_data.totals[scan_idx];
+		idx_t col = 0;
+		output.SetValue(col++, row, Value::UBIGINT(scan_idx + 1));
+		output.SetValue(col++, row, Value(bind_data.patterns[scan_idx]));
+		for (auto count : {totals.scan_units, totals.files_skipped, totals.compressed_bytes, totals.decompressed_bytes,
+		                   totals.lines_read, totals.comment_lines, totals.rows_filtered, totals.rows_emitted}) {
+			output.SetValue(col++, row, Value::UBIGINT(count));
+		}
+		for (auto ns : {totals.read_ns, totals.tokenize_ns, totals.filter_ns, totals.convert_ns, totals.cast_ns}) {
+			output.SetValue(col++, row, Seconds(ns));
+		}
+		row++;
+	}
+	output.SetCardinality(row);
+}
+
+TableFunction GetZeekScanStatsFunction() {
+	return TableFunction("zeek_scan_stats", {}, ZeekScanStatsExecute, ZeekScanStatsBind, ZeekScanStatsInitGlobal);
+}
+
+} // namespace duckdb
@@ -1,37 +1,148 @@
 #include "zeek_reader.hpp"
+#include "zeek_cache.hpp"
+#include "zeek_header_cache.hpp"
+#include "zeek_inet.hpp"
+#include "zeek_json.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/enums/file_compression_type.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/hash.hpp"
 #include "duckdb/common/operator/cast_operators.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
-#include "duckdb/common/operator/comparison_operators.hpp"
-#include "duckdb/planner/filter/constant_filter.hpp"
-#include "duckdb/planner/filter/null_filter.hpp"
-#include "duckdb/planner/filter/conjunction_filter.hpp"
-#include "duckdb/planner/filter/in_filter.hpp"
-#include "duckdb/common/value_operations/value_operations.hpp"
-
+#include "duckdb/execution/execution_context.hpp"
+#include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
+#include "duckdb/storage/statistics/node_statistics.hpp"
+
+#include <algorithm>
 #include <cstring>
 #include <unordered_map>
 
 namespace duckdb {
 
 static constexpr idx_t READ_BUFFER_SIZE = 65536; // 64KB
+//! Read size for remote files (e.g. over httpfs), where each read is a request whose latency
+//! dwarfs the transfer time of a small block.
+static constexpr idx_t REMOTE_READ_BUFFER_SIZE = 8388608; // 8MB
+//! Bounds of the buffer_size parameter.
+static constexpr idx_t MIN_READ_BUFFER_SIZE = 4096;
+static constexpr idx_t MAX_READ_BUFFER_SIZE = 1073741824; // 1GB
+//! Uncompressed files larger than this are split into byte ranges of this size so that several
+//! threads can scan one file.
+static constexpr idx_t SCAN_RANGE_SIZE = 8388608; // 8MB
+//! Rough decompression ratio of gzip/zstd Zeek logs, used to estimate how long a compressed file
+//! takes to scan (relative to uncompressed bytes) when scheduling it.
+static constexpr idx_t COMPRESSION_RATIO_ESTIMATE = 8;
+//! Line length assumed for row count estimates when no data lines could be sampled.
+static constexpr idx_t DEFAULT_LINE_LENGTH_ESTIMATE = 256;
+//! Number of blocks a decompression pipeline may run ahead of its parser.
+static constexpr idx_t PIPELINE_BLOCK_COUNT = 8;
+//! Number of blocks the read-ahead of a remote file may run ahead of its parser: one in flight while
+//! the scanner thread parses the previous one, and one waiting.
+static constexpr idx_t REMOTE_PIPELINE_BLOCK_COUNT = 2;
+
+//! Decode the next non-empty block of a block run into lstate.read_buffer. Returns the number of
+//! bytes decoded (0 at EOF).
+static idx_t ReadCompressedBlock(ZeekScanLocalState &lstate) {
+	auto &blocks = *lstate.blocks;
+	while (lstate.next_block < blocks.size()) {
+		if (lstate.next_block == lstate.unit_block_end) {
+			// Leaving the unit: only the line in progress is still ours. Lines starting after this
+			// point belong to the next unit.
+			lstate.range_end = lstate.buffer_file_offset;
+		}
+		auto &block = blocks[lstate.next_block++];
+		if (block.decompressed_size == 0) {
+			// E.g. the BGZF end-of-file marker.
+			continue;
+		}
+		lstate.compressed_buffer.resize(block.compressed_size);
+		lstate.file_handle->Read(lstate.compressed_buffer.data(), block.compressed_size, block.offset);
+		lstate.counters.compressed_bytes += block.compressed_size;
+		idx_t size = ZeekBlockCodec::DecompressBlock(lstate.block_format, block, lstate.compressed_buffer.data(),
+		                                             lstate.read_buffer->bytes);
+		if (size > 0) {
+			return size;
+		}
+	}
+	return 0;
+}
+
+//! Make lstate.read_buffer a buffer that no output vector or line batch references, so that it can
+//! be refilled without changing strings already handed out or lines not yet converted.
+static void AcquireReadBuffer(ZeekScanLocalState &lstate) {
+	if (lstate.read_buffer.use_count() == 1) {
+		return;
+	}
+	for (auto &spare : lstate.spare_read_buffers) {
+		if (spare.use_count() == 1) {
+			std::swap(spare, lstate.read_buffer);
+			return;
+		}
+	}
+	lstate.spare_read_buffers.push_back(std::move(lstate.read_buffer));
+	lstate.read_buffer = make_buffer<ZeekReadBuffer>(lstate.read_size);
+}
+
+//! Refill lstate.read_buffer with the next block of the current file, from the decompression
+//! pipeline or the block decoder if there is one. Returns the number of bytes read (0 at EOF).
+static idx_t ReadBlock(ZeekScanLocalState &lstate) {
+	const uint64_t start = ZeekScanCounters::Now();
+	AcquireReadBuffer(lstate);
+	auto &bytes = lstate.read_buffer->bytes;
+	idx_t size;
+	if (lstate.blocks) {
+		size = ReadCompressedBlock(lstate);
+	} else if (lstate.pipeline) {
+		size = lstate.pipeline->NextBlock(bytes);
+	} else {
+		// A byte range only reads past its end to finish its last line, which takes a small block
+		// rather than a full (remote-sized) one.
+		idx_t wanted = lstate.read_size;
+		if (lstate.range_end != DConstants::INVALID_INDEX) {
+			const idx_t unit_remaining =
+			    lstate.range_end >= lstate.buffer_file_offset ? lstate.range_end - lstate.buffer_file_offset + 1 : 0;
+			wanted = MinValue<idx_t>(wanted, MaxValue<idx_t>(unit_remaining, READ_BUFFER_SIZE));
+		}
+		if (bytes.size() < wanted) {
+			bytes.resize(lstate.read_size);
+		}
+		size = static_cast<idx_t>(lstate.file_handle->Read(bytes.data(), wanted));
+	}
+	lstate.unreported_bytes += size;
+	lstate.counters.decompressed_bytes += size;
+	if (lstate.uncompressed_unit) {
+		lstate.counters.compressed_bytes += size;
+	}
+	lstate.counters.read_ns += ZeekScanCounters::Now() - start;
+	return size;
+}
 
-static timestamp_tz_t EpochSecondsToTimestampTZ(double epoch_seconds) {
-	int64_t micros = static_cast<int64_t>(epoch_seconds * 1000000.0);
-	return timestamp_tz_t(micros);
+//! Release the current file (and its pipeline, which must be stopped before the handle goes away).
+static void CloseCurrentFile(ZeekScanLocalState &lstate) {
+	lstate.blocks = nullptr;
+	lstate.pipeline.reset();
+	lstate.file_handle.reset();
 }
 
-static interval_t SecondsToInterval(double seconds) {
-	int64_t micros = static_cast<int64_t>(seconds * 1000000.0);
-	return Interval::FromMicro(micros);
+//! Point the current line at `len` bytes at `ptr` (within read_buffer or line_buffer), dropping a
+//! trailing \r (handles \r\n endings).
+static inline void SetCurrentLine(ZeekScanLocalState &lstate, const char *ptr, idx_t len, bool in_read_buffer) {
+	if (len > 0 && ptr[len - 1] == '\r') {
+		len--;
+	}
+	lstate.line_ptr = ptr;
+	lstate.line_len = len;
+	lstate.line_in_read_buffer = in_read_buffer;
 }
 
-//! Read one line from the buffered file into lstate.line_buffer.
-//! Returns false on EOF (with line_buffer empty).
+//! Read one line from the buffered file into lstate.line_ptr / line_len. The line is referenced in
+//! place when it lies within read_buffer and only copied into line_buffer when it spans a refill.
+//! Returns false on EOF.
 static bool ReadLineBuffered(ZeekScanLocalState &lstate) {
 	// If a previous header parse "peeked" at the first data line and stashed it, hand it back.
 	if (lstate.has_pending_line) {
@@ -40,31 +151,40 @@ static bool ReadLineBuffered(ZeekScanLocalState &lstate) {
 	}
 	lstate.line_buffer.clear();
 
+	// A split unit only owns the lines that start at or before its end offset.
+	if (lstate.buffer_file_offset + lstate.buffer_pos > lstate.range_end) {
+		return false;
+	}
+
 	while (true) {
 		// Refill the read buffer if exhausted.
 		if (lstate.buffer_pos >= lstate.buffer_size) {
 			if (lstate.eof_reached) {
+				SetCurrentLine(lstate, lstate.line_buffer.data(), lstate.line_buffer.size(), false);
 				return !lstate.line_buffer.empty();
 			}
-			lstate.buffer_size = lstate.file_handle->Read(lstate.read_buffer.data(), lstate.read_buffer.size());
+			lstate.buffer_file_offset += lstate.buffer_size;
+			lstate.buffer_size = ReadBlock(lstate);
 			lstate.buffer_pos = 0;
 			if (lstate.buffer_size == 0) {
 				lstate.eof_reached = true;
+				SetCurrentLine(lstate, lstate.line_buffer.data(), lstate.line_buffer.size(), false);
 				return !lstate.line_buffer.empty();
 			}
 		}
 
-		const char *start = lstate.read_buffer.data() + lstate.buffer_pos;
+		const char *start = lstate.read_buffer->bytes.data() + lstate.buffer_pos;
 		idx_t remaining = lstate.buffer_size - lstate.buffer_pos;
 		const char *newline = static_cast<const char *>(std::memchr(start, '\n', remaining));
 
 		if (newline) {
 			idx_t line_len = static_cast<idx_t>(newline - start);
-			lstate.line_buffer.insert(lstate.line_buffer.end(), start, start + line_len);
 			lstate.buffer_pos += line_len + 1;
-			// Strip trailing \r if present (handles \r\n line endings even across buffer boundaries).
-			if (!lstate.line_buffer.empty() && lstate.line_buffer.back() == '\r') {
-				lstate.line_buffer.pop_back();
+			if (lstate.line_buffer.empty()) {
+				SetCurrentLine(lstate, start, line_len, true);
+			} else {
+				lstate.line_buffer.insert(lstate.line_buffer.end(), start, start + line_len);
+				SetCurrentLine(lstate, lstate.line_buffer.data(), lstate.line_buffer.size(), false);
 			}
 			return true;
 		}
@@ -75,17 +195,280 @@ static bool ReadLineBuffered(ZeekScanLocalState &lstate) {
 	}
 }
 
-//! Tokenize a span by separator into the given slices vector (reused).
-static void TokenizeSpan(const char *data, uint32_t len, char separator, vector<FieldSlice> &slices) {
-	slices.clear();
-	uint32_t start = 0;
-	for (uint32_t i = 0; i < len; i++) {
-		if (data[i] == separator) {
-			slices.push_back({data + start, i - start});
-			start = i + 1;
+//! Read the next line like ReadLineBuffered and split its first lstate.filter_fields fields at
+//! `separator` into lstate.field_slices. A line that lies within read_buffer is found and tokenized
+//! in the same vectorized pass; only lines spanning a refill (one per buffer) take the
+//! ReadLineBuffered path and are tokenized after.
+static bool ReadLineTokenized(ZeekScanLocalState &lstate, char separator) {
+	if (!lstate.has_pending_line && lstate.buffer_pos < lstate.buffer_size &&
+	    lstate.buffer_file_offset + lstate.buffer_pos <= lstate.range_end) {
+		const char *start = lstate.read_buffer->bytes.data() + lstate.buffer_pos;
+		const idx_t remaining = lstate.buffer_size - lstate.buffer_pos;
+		const idx_t line_len = ZeekTokenizer::TokenizeLine(start, remaining, separator, lstate.field_slices,
+		                                                   lstate.filter_fields);
+		if (line_len < remaining) {
+			lstate.buffer_pos += line_len + 1;
+			SetCurrentLine(lstate, start, line_len, true);
+			// The \r stripped from the line ends its last field, unless tokenizing stopped early.
+			auto &slices = lstate.field_slices;
+			if (lstate.line_len < line_len && !slices.empty() &&
+			    slices.back().ptr + slices.back().len == start + line_len) {
+				slices.back().len--;
+			}
+			return true;
+		}
+	}
+	if (!ReadLineBuffered(lstate)) {
+		return false;
+	}
+	ZeekTokenizer::TokenizeLine(lstate.line_ptr, lstate.line_len, separator, lstate.field_slices,
+	                            lstate.filter_fields);
+	return true;
+}
+
+//! Split row `r` of the line batch, which ReadLineTokenized split up to lstate.filter_fields fields,
+//! the rest of the way to lstate.max_needed_fields.
+static void FinishTokenizing(ZeekScanLocalState &lstate, idx_t r, char separator) {
+	auto &row = lstate.batch.rows[r];
+	FieldSlice *slices = lstate.batch.slices.data() + r * lstate.batch.stride;
+	if (row.field_count < lstate.filter_fields || row.field_count >= lstate.max_needed_fields) {
+		// The line has no more fields, or has all those needed.
+		return;
+	}
+	// Tokenizing stopped at the separator after the last slice, unless that is where the line ends.
+	const char *rest = row.line_ptr;
+	const char *line_end = row.line_ptr + row.line_len;
+	if (row.field_count > 0) {
+		const FieldSlice &last = slices[row.field_count - 1];
+		rest = last.ptr + last.len;
+		if (rest >= line_end) {
+			return;
+		}
+		rest++;
+	}
+	ZeekTokenizer::TokenizeLine(rest, UnsafeNumericCast<idx_t>(line_end - rest), separator,
+	                            lstate.remaining_slices, lstate.max_needed_fields - row.field_count);
+	std::copy(lstate.remaining_slices.begin(), lstate.remaining_slices.end(), slices + row.field_count);
+	row.field_count += lstate.remaining_slices.size();
+}
+
+//! Read the next line of a JSON log like ReadLineBuffered and split it into lstate.field_slices with
+//! ZeekJson::TokenizeLine. Empty and comment lines are left for the caller to skip.
+static bool ReadLineJson(ZeekScanLocalState &lstate) {
+	if (!ReadLineBuffered(lstate)) {
+		return false;
+	}
+	if (lstate.line_len == 0 || lstate.line_ptr[0] == '#') {
+		return true;
+	}
+	if (ZeekJson::TokenizeLine(lstate.line_ptr, lstate.line_len, *lstate.json_fields, lstate.field_slices,
+	                           lstate.json_scratch)) {
+		// Some values were unescaped into json_scratch, which the next line overwrites.
+		lstate.line_in_read_buffer = false;
+	}
+	return true;
+}
+
+//! Add the current line, split into lstate.field_slices, to the line batch with its first stride
+//! slices. A line that doesn't lie within read_buffer is copied into the batch's arena, together
+//! with the JSON values unescaped from it into json_scratch (which the next line overwrites), and
+//! its slices are moved along.
+static void AddBatchRow(ZeekScanLocalState &lstate, idx_t next_offset) {
+	auto &batch = lstate.batch;
+	ZeekLineBatch::Row row;
+	row.line_ptr = lstate.line_ptr;
+	row.line_len = lstate.line_len;
+	row.field_count = MinValue<idx_t>(lstate.field_slices.size(), batch.stride);
+	row.next_offset = next_offset;
+	FieldSlice *slices = batch.slices.data() + batch.rows.size() * batch.stride;
+	std::copy(lstate.field_slices.begin(), lstate.field_slices.begin() + row.field_count, slices);
+	if (lstate.line_in_read_buffer) {
+		if (batch.buffers.empty() || batch.buffers.back().get() != lstate.read_buffer.get()) {
+			batch.buffers.push_back(lstate.read_buffer);
+		}
+		row.buffer_idx = batch.buffers.size() - 1;
+		batch.rows.push_back(row);
+		return;
+	}
+	const char *line_end = row.line_ptr + row.line_len;
+	const char *scratch = lstate.json_scratch.data();
+	const char *scratch_end = scratch + lstate.json_scratch.size();
+	idx_t scratch_len = 0;
+	if (lstate.json) {
+		for (idx_t i = 0; i < row.field_count; i++) {
+			const auto &slice = slices[i];
+			if (slice.ptr >= scratch && slice.ptr < scratch_end) {
+				scratch_len = MaxValue<idx_t>(scratch_len, UnsafeNumericCast<idx_t>(slice.ptr + slice.len - scratch));
+			}
+		}
+	}
+	auto copy = char_ptr_cast(batch.arena.Allocate(row.line_len + scratch_len));
+	std::memcpy(copy, row.line_ptr, row.line_len);
+	if (scratch_len > 0) {
+		std::memcpy(copy + row.line_len, scratch, scratch_len);
+	}
+	for (idx_t i = 0; i < row.field_count; i++) {
+		auto &slice = slices[i];
+		if (slice.ptr >= row.line_ptr && slice.ptr <= line_end) {
+			slice.ptr = copy + (slice.ptr - row.line_ptr);
+		} else if (slice.ptr >= scratch && slice.ptr < scratch_end) {
+			slice.ptr = copy + row.line_len + (slice.ptr - scratch);
+		}
+	}
+	row.line_ptr = copy;
+	row.buffer_idx = DConstants::INVALID_INDEX;
+	batch.rows.push_back(row);
+}
+
+//! Read the next data lines of the current unit into lstate.batch, up to `max_rows` of them, split up
+//! to lstate.filter_fields fields. Empty and comment lines are skipped, as are in tail mode a last
+//! line still missing its newline (left for the next call) and the lines before the resume offset.
+//! Returns false once the unit has no more lines.
+static bool ReadLineBatch(const ZeekScanBindData &bind_data, ZeekScanLocalState &lstate, idx_t max_rows) {
+	auto &batch = lstate.batch;
+	batch.number++;
+	batch.stride = lstate.max_needed_fields;
+	if (batch.slices.size() < max_rows * batch.stride) {
+		batch.slices.resize(max_rows * batch.stride);
+	}
+	const char field_separator = bind_data.header.separator;
+	while (batch.rows.size() < max_rows) {
+		if (!(lstate.json ? ReadLineJson(lstate) : ReadLineTokenized(lstate, field_separator))) {
+			return false;
+		}
+		lstate.counters.lines_read++;
+
+		idx_t next_offset = 0;
+		if (bind_data.tail) {
+			if (lstate.eof_reached) {
+				continue;
+			}
+			next_offset = lstate.unit_stream_offset + lstate.buffer_file_offset + lstate.buffer_pos;
+			if (next_offset <= lstate.resume_offset) {
+				continue;
+			}
+		}
+		if (lstate.line_len == 0 || lstate.line_ptr[0] == '#') {
+			if (lstate.line_len > 0) {
+				lstate.counters.comment_lines++;
+			}
+			continue;
+		}
+		AddBatchRow(lstate, next_offset);
+	}
+	return true;
+}
+
+//! Empty the line batch once its rows were converted, letting go of its read buffers (those that
+//! output vectors reference stay with them) and of its arena's copies.
+static void ReleaseLineBatch(ZeekScanLocalState &lstate) {
+	lstate.batch.rows.clear();
+	lstate.batch.buffers.clear();
+	lstate.batch.arena.Reset();
+}
+
+//! Store `field` of the row being converted as row `row_idx` of VARCHAR vector `vec` (output column
+//! input.out_idx, or its list child). With zero_copy the string references the read buffer the row's
+//! line lies within, which is attached to the vector the first time the column references it in this
+//! chunk; fields of lines copied into the batch's arena are always copied.
+static inline void WriteStringField(ZeekConvertInput &input, Vector &vec, idx_t row_idx, const FieldSlice &field) {
+	auto &result = FlatVector::GetData<string_t>(vec)[row_idx];
+	if (!input.bind_data.zero_copy || input.buffer_idx == DConstants::INVALID_INDEX) {
+		result = StringVector::AddString(vec, field.ptr, field.len);
+		return;
+	}
+	auto &buffer = input.lstate.batch.buffers[input.buffer_idx];
+	auto &attached = input.lstate.attached_read_buffers[input.out_idx];
+	if (attached != buffer.get()) {
+		StringVector::AddBuffer(vec, buffer);
+		attached = buffer.get();
+	}
+	result = string_t(field.ptr, field.len);
+}
+
+//! COUNT(*) fast path: add up to `max_rows` rows of the current unit to `row_count`, counting them
+//! in place in the read buffer with ZeekTokenizer::CountRows instead of reading line by line.
+//! Returns false once the unit has no more rows.
+static bool CountRowsBuffered(ZeekScanLocalState &lstate, idx_t max_rows, idx_t &row_count) {
+	if (lstate.has_pending_line) {
+		// The first data line, already read by the header parser.
+		lstate.has_pending_line = false;
+		if (lstate.line_len > 0 && lstate.line_ptr[0] != '#') {
+			row_count++;
+			max_rows--;
+		}
+	}
+	idx_t rows = 0;
+	while (rows < max_rows) {
+		// A split unit only owns the lines that start at or before its end offset.
+		if (!lstate.count_pending_cr && lstate.buffer_file_offset + lstate.buffer_pos > lstate.range_end) {
+			break;
+		}
+		if (lstate.buffer_pos >= lstate.buffer_size) {
+			if (lstate.eof_reached) {
+				break;
+			}
+			lstate.buffer_file_offset += lstate.buffer_size;
+			lstate.buffer_size = ReadBlock(lstate);
+			lstate.buffer_pos = 0;
+			if (lstate.buffer_size == 0) {
+				lstate.eof_reached = true;
+				break;
+			}
+			continue;
+		}
+		const char *data = lstate.read_buffer->bytes.data();
+		if (lstate.count_pending_cr) {
+			// The previous buffer ended in a '\r' starting a line, which is empty if a newline follows.
+			lstate.count_pending_cr = false;
+			if (data[lstate.buffer_pos] == '\n') {
+				lstate.buffer_pos++;
+				continue;
+			}
+			rows++;
+			lstate.count_mid_line = true;
+		}
+		if (lstate.count_mid_line) {
+			// Skip the rest of a line that was counted in the previous buffer.
+			auto newline = static_cast<const char *>(
+			    std::memchr(data + lstate.buffer_pos, '\n', lstate.buffer_size - lstate.buffer_pos));
+			lstate.count_mid_line = !newline;
+			lstate.buffer_pos = newline ? static_cast<idx_t>(newline - data) + 1 : lstate.buffer_size;
+			continue;
+		}
+
+		idx_t limit = lstate.buffer_size;
+		if (lstate.range_end != DConstants::INVALID_INDEX) {
+			limit = MinValue<idx_t>(limit, lstate.range_end + 1 - lstate.buffer_file_offset);
+		}
+		const idx_t len = limit - lstate.buffer_pos;
+		idx_t consumed;
+		const idx_t counted = ZeekTokenizer::CountRows(data + lstate.buffer_pos, len, max_rows - rows, consumed);
+		rows += counted;
+		if (consumed == len) {
+			lstate.buffer_pos = limit;
+			lstate.count_mid_line = data[limit - 1] != '\n';
+		} else if (rows == max_rows) {
+			// Stopped at the start of the next row.
+			lstate.buffer_pos += consumed;
+		} else {
+			lstate.buffer_pos += consumed + 1;
+			lstate.count_pending_cr = true;
 		}
 	}
-	slices.push_back({data + start, len - start});
+	row_count += rows;
+	return rows == max_rows;
+}
+
+//! Take up to `max_rows` of the rows that InitGlobal counted from indexes instead of scanning.
+static idx_t ClaimIndexedRows(ZeekScanGlobalState &gstate, idx_t max_rows) {
+	idx_t available = gstate.indexed_row_count.load(std::memory_order_relaxed);
+	idx_t claimed;
+	do {
+		claimed = MinValue<idx_t>(available, max_rows);
+	} while (claimed > 0 && !gstate.indexed_row_count.compare_exchange_weak(available, available - claimed,
+	                                                                          std::memory_order_relaxed));
+	return claimed;
 }
 
 //! Compare a slice to a string for equality (used for unset/empty markers).
@@ -93,9 +476,95 @@ static inline bool SliceEquals(const FieldSlice &s, const string &str) {
 	return s.len == str.size() && std::memcmp(s.ptr, str.data(), s.len) == 0;
 }
 
-//! Returns true if the given type is handled directly in the per-row switch (no batch cast needed).
-static bool IsNativelyHandled(const LogicalType &type) {
+//! Whether row `r` of the line batch passes `filter` on schema column `schema_col`: the file's path
+//! for the filename column, else the row's field. In union mode the field may be absent (idx_t(-1)
+//! wraps to a value larger than the row's field count); absent fields and unset/empty markers are
+//! NULL.
+static inline bool FieldPassesFilter(const ZeekScanBindData &bind_data, const ZeekScanLocalState &lstate,
+                                     const ZeekColumnFilter &filter, column_t schema_col, idx_t r) {
+	if (schema_col >= bind_data.column_types.size()) {
+		const auto &path = lstate.current_file_path;
+		return filter.Evaluate({path.data(), static_cast<uint32_t>(path.size())});
+	}
+	const idx_t file_field_idx = lstate.field_lookup[schema_col];
+	if (file_field_idx >= lstate.batch.rows[r].field_count) {
+		return filter.EvaluateNull();
+	}
+	const FieldSlice &field = lstate.batch.slices[r * lstate.batch.stride + file_field_idx];
+	if (SliceEquals(field, lstate.markers->unset_field) || SliceEquals(field, lstate.markers->empty_field)) {
+		return filter.EvaluateNull();
+	}
+	return filter.Evaluate(field);
+}
+
+//! Entry of `dict` (the dictionary of schema column `schema_col`) for row `r` of the line batch.
+static sel_t LookupDictionaryEntry(const ZeekScanBindData &bind_data, const ZeekScanLocalState &lstate,
+                                   ZeekColumnDictionary &dict, column_t schema_col, idx_t r) {
+	const idx_t file_field_idx = lstate.field_lookup[schema_col];
+	if (file_field_idx >= lstate.batch.rows[r].field_count) {
+		return dict.NullEntry();
+	}
+	const FieldSlice &field = lstate.batch.slices[r * lstate.batch.stride + file_field_idx];
+	if (SliceEquals(field, lstate.markers->unset_field) || SliceEquals(field, lstate.markers->empty_field)) {
+		return dict.NullEntry();
+	}
+	return dict.Lookup(field.ptr, field.len);
+}
+
+//! Evaluate the pushed-down filters, and the dynamic filters (by the constant they had when the chunk
+//! began), on the rows of the line batch one column at a time, leaving the rows that pass all of
+//! them in batch.sel. Dictionary-encoded columns evaluate their filter once per distinct value, and
+//! keep the entries they looked up for the conversion.
+static void FilterLineBatch(const ZeekScanBindData &bind_data, const ZeekScanGlobalState &gstate,
+                            ZeekScanLocalState &lstate) {
+	auto &batch = lstate.batch;
+	auto &sel = batch.sel;
+	idx_t count = batch.rows.size();
+	for (idx_t i = 0; i < count; i++) {
+		sel.set_index(i, i);
+	}
+	for (auto &entry : gstate.column_filters) {
+		const ZeekColumnFilter &filter = *entry.filter;
+		idx_t kept = 0;
+		if (entry.schema_col < lstate.dictionaries.size() && lstate.dictionaries[entry.schema_col]) {
+			auto &dict = *lstate.dictionaries[entry.schema_col];
+			for (idx_t i = 0; i < count; i++) {
+				const idx_t r = sel.get_index(i);
+				const sel_t dict_entry = LookupDictionaryEntry(bind_data, lstate, dict, entry.schema_col, r);
+				dict.batch_entries[r] = dict_entry;
+				if (dict.EvaluateFilter(filter, dict_entry)) {
+					sel.set_index(kept++, r);
+				}
+			}
+			dict.batch_number = batch.number;
+		} else {
+			for (idx_t i = 0; i < count; i++) {
+				const idx_t r = sel.get_index(i);
+				if (FieldPassesFilter(bind_data, lstate, filter, entry.schema_col, r)) {
+					sel.set_index(kept++, r);
+				}
+			}
+		}
+		count = kept;
+	}
+	for (auto &entry : lstate.active_dynamic_filters) {
+		idx_t kept = 0;
+		for (idx_t i = 0; i < count; i++) {
+			const idx_t r = sel.get_index(i);
+			if (FieldPassesFilter(bind_data, lstate, *entry.filter, entry.schema_col, r)) {
+				sel.set_index(kept++, r);
+			}
+		}
+		count = kept;
+	}
+	batch.selected = count;
+}
+
+//! Returns true if the given type has a native converter (no batch cast needed).
+static bool IsNativelyHandled(const LogicalType &type, bool native_inet) {
 	switch (type.id()) {
+	case LogicalTypeId::STRUCT:
+		return native_inet && ZeekInet::IsInetType(type);
 	case LogicalTypeId::VARCHAR:
 	case LogicalTypeId::DOUBLE:
 	case LogicalTypeId::UBIGINT:
@@ -104,8 +573,9 @@ static bool IsNativelyHandled(const LogicalType &type) {
 	case LogicalTypeId::TIMESTAMP_TZ:
 	case LogicalTypeId::INTERVAL:
 	case LogicalTypeId::USMALLINT:
-	case LogicalTypeId::LIST:
 		return true;
+	case LogicalTypeId::LIST:
+		return IsNativelyHandled(ListType::GetChildType(type), native_inet);
 	default:
 		return false;
 	}
@@ -113,10 +583,12 @@ static bool IsNativelyHandled(const LogicalType &type) {
 
 //! Returns true if filter pushdown is efficient for this column type (see supports_pushdown_type).
 //! We only advertise pushdown for types we can parse from a slice without going through an
-//! extension cast — LIST and INET are excluded because per-row evaluation would be slower than
-//! letting DuckDB filter post-scan.
-static bool CanPushdownFilterOnType(const LogicalType &type) {
+//! extension cast — LIST (and INET when it isn't decoded natively) are excluded because per-row
+//! evaluation would be slower than letting DuckDB filter post-scan.
+static bool CanPushdownFilterOnType(const LogicalType &type, bool native_inet) {
 	switch (type.id()) {
+	case LogicalTypeId::STRUCT:
+		return native_inet && ZeekInet::IsInetType(type);
 	case LogicalTypeId::VARCHAR:
 	case LogicalTypeId::DOUBLE:
 	case LogicalTypeId::UBIGINT:
@@ -131,153 +603,190 @@ static bool CanPushdownFilterOnType(const LogicalType &type) {
 	}
 }
 
-//! Parse a slice into a DuckDB Value of the given type. Returns a NULL Value of the target type
-//! on parse failure. This is only called for filter columns and only for types where
-//! CanPushdownFilterOnType returns true.
-static Value SliceToValue(const FieldSlice &field, const LogicalType &type) {
-	string_t s(field.ptr, field.len);
-	switch (type.id()) {
-	case LogicalTypeId::VARCHAR:
-		return Value(string(field.ptr, field.len));
-	case LogicalTypeId::DOUBLE: {
-		double v;
-		if (TryCast::Operation<string_t, double>(s, v)) {
-			return Value::DOUBLE(v);
-		}
-		return Value(type);
-	}
-	case LogicalTypeId::UBIGINT: {
-		uint64_t v;
-		if (TryCast::Operation<string_t, uint64_t>(s, v)) {
-			return Value::UBIGINT(v);
-		}
-		return Value(type);
-	}
-	case LogicalTypeId::BIGINT: {
-		int64_t v;
-		if (TryCast::Operation<string_t, int64_t>(s, v)) {
-			return Value::BIGINT(v);
-		}
-		return Value(type);
-	}
-	case LogicalTypeId::BOOLEAN: {
-		bool b = (field.len == 1 && field.ptr[0] == 'T') || (field.len == 4 && std::memcmp(field.ptr, "true", 4) == 0);
-		return Value::BOOLEAN(b);
-	}
-	case LogicalTypeId::USMALLINT: {
-		uint16_t v;
-		if (TryCast::Operation<string_t, uint16_t>(s, v)) {
-			return Value::USMALLINT(v);
-		}
-		return Value(type);
-	}
-	case LogicalTypeId::TIMESTAMP_TZ: {
-		double v;
-		if (TryCast::Operation<string_t, double>(s, v)) {
-			return Value::TIMESTAMPTZ(EpochSecondsToTimestampTZ(v));
-		}
-		return Value(type);
-	}
-	case LogicalTypeId::INTERVAL: {
-		double v;
-		if (TryCast::Operation<string_t, double>(s, v)) {
-			return Value::INTERVAL(SecondsToInterval(v));
-		}
-		return Value(type);
+//! Try to split a block-compressed file into runs of blocks of about SCAN_RANGE_SIZE decompressed
+//! bytes each. Returns false (leaving the file unsplit) if it isn't block-compressed or is too small.
+static bool AddBlockUnits(FileHandle &handle, idx_t file_idx, ZeekScanGlobalState &gstate) {
+	auto &blocks = gstate.file_blocks[file_idx];
+	auto format = ZeekBlockCodec::DetectBlocks(handle, blocks);
+	if (format == ZeekBlockFormat::NONE) {
+		return false;
 	}
-	default:
-		// Should never be reached — CanPushdownFilterOnType restricts the types we see here.
-		return Value(type);
-	}
-}
-
-//! Evaluate a filter against a value. `is_null` indicates whether `val` represents a SQL NULL
-//! (Value is not null-tagged otherwise). Returns true if the row passes the filter.
-static bool EvaluateFilter(const TableFilter &filter, const Value &val, bool is_null) {
-	switch (filter.filter_type) {
-	case TableFilterType::IS_NULL:
-		return is_null;
-	case TableFilterType::IS_NOT_NULL:
-		return !is_null;
-	case TableFilterType::CONSTANT_COMPARISON: {
-		if (is_null) {
-			// NULL compared with anything is NULL → row filtered out.
-			return false;
+	vector<ZeekScanUnit> file_units;
+	idx_t run_start = 0;
+	idx_t run_size = 0;
+	for (idx_t i = 0; i < blocks.size(); i++) {
+		run_size += blocks[i].decompressed_size;
+		if (run_size >= SCAN_RANGE_SIZE || i + 1 == blocks.size()) {
+			file_units.push_back({file_idx, run_start, i + 1, format, run_size});
+			run_start = i + 1;
+			run_size = 0;
 		}
-		return filter.Cast<ConstantFilter>().Compare(val);
 	}
-	case TableFilterType::IN_FILTER: {
-		if (is_null) {
-			return false;
-		}
-		auto &in_filter = filter.Cast<InFilter>();
-		for (auto &v : in_filter.values) {
-			if (!v.IsNull() && ValueOperations::Equals(v, val)) {
-				return true;
-			}
-		}
+	if (file_units.size() < 2) {
+		blocks.clear();
 		return false;
 	}
-	case TableFilterType::CONJUNCTION_AND: {
-		auto &conj = filter.Cast<ConjunctionAndFilter>();
-		for (auto &child : conj.child_filters) {
-			if (!EvaluateFilter(*child, val, is_null)) {
-				return false;
+	gstate.units.insert(gstate.units.end(), file_units.begin(), file_units.end());
+	return true;
+}
+
+//! Append the scan units for one file: a single whole-file unit, SCAN_RANGE_SIZE byte ranges if the
+//! file is uncompressed, seekable and large enough to be worth splitting, or block runs if it is a
+//! large BGZF / seekable zstd file. Only local compressed files are opened, to walk their block
+//! tables; the others are split by the size bind found.
+static void AddScanUnits(FileSystem &fs, const ZeekScanBindData &bind_data, idx_t file_idx,
+                         ZeekScanGlobalState &gstate) {
+	const string &path = bind_data.file_paths[file_idx];
+	const bool compressed = ZeekReader::IsCompressedPath(path);
+	const idx_t bound_size = bind_data.file_sizes[file_idx];
+	const idx_t file_size = bound_size == DConstants::INVALID_INDEX ? 0 : bound_size;
+	// Walking a BGZF block table takes a small read per chunk, which is only cheap locally. Remote
+	// compressed files are scheduled whole.
+	if (compressed && !FileSystem::IsRemoteFile(path)) {
+		try {
+			auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+			if (AddBlockUnits(*handle, file_idx, gstate)) {
+				return;
 			}
+		} catch (const std::exception &e) {
+			// Leave the file unsplit; OpenNextFile reports (or skips) the error when it claims it.
+			gstate.file_blocks[file_idx].clear();
 		}
-		return true;
 	}
-	case TableFilterType::CONJUNCTION_OR: {
-		auto &conj = filter.Cast<ConjunctionOrFilter>();
-		for (auto &child : conj.child_filters) {
-			if (EvaluateFilter(*child, val, is_null)) {
-				return true;
-			}
-		}
-		return false;
+	if (compressed || file_size <= SCAN_RANGE_SIZE) {
+		const idx_t scan_size = compressed ? file_size * COMPRESSION_RATIO_ESTIMATE : file_size;
+		gstate.units.push_back({file_idx, 0, DConstants::INVALID_INDEX, ZeekBlockFormat::NONE, scan_size});
+		return;
 	}
-	default:
-		// Unknown filter type — be safe: let the row through, DuckDB will re-evaluate post-scan.
-		return true;
+	for (idx_t start = 0; start < file_size; start += SCAN_RANGE_SIZE) {
+		const idx_t end = MinValue<idx_t>(start + SCAN_RANGE_SIZE, file_size);
+		gstate.units.push_back({file_idx, start, end, ZeekBlockFormat::NONE, end - start});
+	}
+}
+
+//! Reset the buffered reader so that the next read starts at `file_offset`.
+static void ResetReadBuffer(ZeekScanLocalState &lstate, idx_t file_offset) {
+	lstate.buffer_pos = 0;
+	lstate.buffer_size = 0;
+	lstate.buffer_file_offset = file_offset;
+	lstate.eof_reached = false;
+	lstate.has_pending_line = false;
+	lstate.count_mid_line = false;
+	lstate.count_pending_cr = false;
+}
+
+//! Tail-mode identity of a log (see ZeekScanLocalState::current_log_id).
+static string LogId(const ZeekHeader &header, const string &path) {
+	if (header.open_time.empty()) {
+		return path;
 	}
+	return header.path + "@" + header.open_time;
 }
 
-//! Atomically claim the next file from the shared queue and open it for the calling thread.
-//! Returns false if no more files remain.
+//! Atomically claim the next scan unit from the shared queue and open its file for the calling
+//! thread. Returns false if no more units remain.
 static bool OpenNextFile(ClientContext &context, ZeekScanGlobalState &gstate, ZeekScanLocalState &lstate,
                          const ZeekScanBindData &bind_data) {
 	auto &fs = FileSystem::GetFileSystem(context);
 
 	while (true) {
-		idx_t my_file_idx = gstate.next_file_idx.fetch_add(1, std::memory_order_relaxed);
-		if (my_file_idx >= bind_data.file_paths.size()) {
+		idx_t my_unit_idx = gstate.next_unit_idx.fetch_add(1, std::memory_order_relaxed);
+		if (my_unit_idx >= gstate.units.size()) {
 			return false;
 		}
+		const ZeekScanUnit &unit = gstate.units[my_unit_idx];
+		const idx_t my_file_idx = unit.file_idx;
+		lstate.batch_index = gstate.indexed_batch_count + my_unit_idx;
 
 		lstate.current_file_idx = my_file_idx;
 		lstate.current_file_path = bind_data.file_paths[my_file_idx];
 
 		try {
-			lstate.file_handle =
-			    fs.OpenFile(lstate.current_file_path, FileFlags::FILE_FLAGS_READ | FileCompressionType::AUTO_DETECT);
+			// Split units are opened without a decompressing wrapper: byte ranges exist only for
+			// uncompressed files (keeping offsets and Seek() meaningful), and block runs are decoded
+			// block by block.
+			auto flags = unit.IsRange() ? FileOpenFlags(FileFlags::FILE_FLAGS_READ)
+			                            : FileFlags::FILE_FLAGS_READ | FileCompressionType::AUTO_DETECT;
+			CloseCurrentFile(lstate);
+			lstate.file_handle = fs.OpenFile(lstate.current_file_path, flags);
+			const bool remote = FileSystem::IsRemoteFile(lstate.current_file_path);
+			const bool compressed = ZeekReader::IsCompressedPath(lstate.current_file_path);
+			lstate.read_size = bind_data.buffer_size > 0 ? bind_data.buffer_size
+			                   : remote                  ? REMOTE_READ_BUFFER_SIZE
+			                                             : READ_BUFFER_SIZE;
+#ifndef DUCKDB_NO_THREADS
+			// Hand decompression to read-ahead tasks; this thread then mostly tokenizes and converts.
+			// Remote files are read ahead the same way, so that the next request is in flight while
+			// this thread parses the current block. (Uncompressed logs resumed in tail mode seek first.)
+			auto &scheduler = TaskScheduler::GetScheduler(context);
+			if (!unit.IsRange() && bind_data.parallel_decompression && compressed) {
+				lstate.pipeline = make_uniq<ZeekBlockPipeline>(scheduler, *lstate.file_handle, lstate.read_size,
+				                                               PIPELINE_BLOCK_COUNT);
+			} else if (!unit.IsRange() && remote && (compressed || !bind_data.tail)) {
+				lstate.pipeline = make_uniq<ZeekBlockPipeline>(scheduler, *lstate.file_handle, lstate.read_size,
+				                                               REMOTE_PIPELINE_BLOCK_COUNT);
+			}
+#endif
 
 			// Reset buffer state for the new file.
-			lstate.buffer_pos = 0;
-			lstate.buffer_size = 0;
-			lstate.eof_reached = false;
-			lstate.has_pending_line = false;
+			ResetReadBuffer(lstate, 0);
+			lstate.range_end = DConstants::INVALID_INDEX;
+			lstate.unit_stream_offset = 0;
+			if (unit.block_format != ZeekBlockFormat::NONE) {
+				// Decode from block 0 for the header; the unit's own blocks come afterwards.
+				lstate.block_format = unit.block_format;
+				lstate.blocks = &gstate.file_blocks[my_file_idx];
+				lstate.next_block = 0;
+				lstate.unit_block_end = DConstants::INVALID_INDEX;
+			}
+			lstate.uncompressed_unit = !compressed;
+			if (!lstate.uncompressed_unit && !lstate.blocks) {
+				// Compressed streams are read to their end.
+				lstate.counters.compressed_bytes += lstate.file_handle->GetFileSize();
+			}
 
 			// Parse this file's header via the buffered reader. We read lines until we hit the first
 			// non-directive (data) line, parse each `#` line as a directive, and leave the first data
-			// line in line_buffer with has_pending_line=true so the hot loop can consume it without
-			// re-reading.
-			ZeekHeader file_header;
+			// line current with has_pending_line=true so the hot loop can consume it without
+			// re-reading. Ranges past the first one re-read the (small) header too, so that every
+			// unit of a file is validated against the bound schema and ignore_file_errors skips all
+			// of a broken file rather than just its first range. If bind already parsed the header,
+			// and the file hasn't changed since, its lines are only skipped. (A JSON log has no header
+			// lines, and its lines are matched to fields by key, so its inferred header stays valid.)
+			shared_ptr<const ZeekHeader> bound_header = bind_data.file_headers[my_file_idx];
+			lstate.file_changed = false;
+			if (bound_header && !bound_header->json &&
+			    (lstate.file_handle->GetFileSize() != bound_header->source_size ||
+			     fs.GetLastModifiedTime(*lstate.file_handle).value != bound_header->source_mtime)) {
+				bound_header = nullptr;
+				lstate.file_changed = true;
+			}
+			ZeekHeader parsed_header;
 			while (ReadLineBuffered(lstate)) {
-				if (!ZeekReader::ApplyHeaderLine(lstate.line_buffer.data(), lstate.line_buffer.size(), file_header)) {
+				const bool is_directive =
+				    bound_header ? lstate.line_len > 0 && lstate.line_ptr[0] == '#'
+				                 : ZeekReader::ApplyHeaderLine(lstate.line_ptr, lstate.line_len, parsed_header);
+				if (!is_directive) {
 					lstate.has_pending_line = true;
 					break;
 				}
 			}
+			// A JSON log has no header lines. Unless bind inferred this file's header, it is read with
+			// the header inferred from the first file, which must then be a JSON log too.
+			const ZeekHeader *file_header_ptr = bound_header ? bound_header.get() : &parsed_header;
+			if (!bound_header && parsed_header.fields.empty() && lstate.has_pending_line &&
+			    ZeekJson::IsJsonLine(lstate.line_ptr, lstate.line_len)) {
+				if (!bind_data.header.json) {
+					throw InvalidInputException(
+					    "read_zeek: file '%s' is a JSON log, but '%s' (the first file in the glob) is not",
+					    lstate.current_file_path, bind_data.file_paths[0]);
+				}
+				file_header_ptr = &bind_data.header;
+			}
+			const ZeekHeader &file_header = *file_header_ptr;
+			lstate.json = file_header.json;
+			lstate.markers = file_header.json ? &ZeekJson::Markers() : &bind_data.header;
+			lstate.json_fields = file_header.json ? make_uniq<ZeekJsonFieldMap>(file_header.fields) : nullptr;
 
 			if (file_header.fields.empty()) {
 				throw InvalidInputException("read_zeek: file '%s' is missing #fields directive",
@@ -292,14 +801,19 @@ static bool OpenNextFile(ClientContext &context, ZeekScanGlobalState &gstate, Ze
 				                            lstate.current_file_path);
 			}
 
-			// In strict mode, the bound schema must match this file exactly.
+			// In strict mode, the bound schema must match this file exactly. In union mode, the field
+			// mapping bind built from this file's header must still hold for a file rewritten since.
+			string mismatch;
 			if (!bind_data.union_by_name) {
-				string mismatch;
 				if (!SameSchema(bind_data.header, file_header, mismatch)) {
 					throw InvalidInputException(
 					    "read_zeek: file '%s' has a different schema than '%s' (the first file in the glob): %s",
 					    lstate.current_file_path, bind_data.file_paths[0], mismatch);
 				}
+			} else if (!bound_header && bind_data.file_headers[my_file_idx] &&
+			           !SameSchema(*bind_data.file_headers[my_file_idx], file_header, mismatch)) {
+				throw InvalidInputException("read_zeek: file '%s' changed its schema while the query ran: %s",
+				                            lstate.current_file_path, mismatch);
 			}
 
 			// Build the per-file field lookup table used by the hot loop.
@@ -314,13 +828,90 @@ static bool OpenNextFile(ClientContext &context, ZeekScanGlobalState &gstate, Ze
 					lstate.field_lookup[i] = i;
 				}
 			}
+			// The tokenizer can stop after the last field of this file that the projection (which
+			// includes the filter columns) needs. Lines are first only split up to the last field the
+			// filters need, and the rows that pass them are split the rest of the way.
+			auto needed_fields = [&](column_t schema_col) -> idx_t {
+				if (schema_col >= bound_col_count || lstate.field_lookup[schema_col] == DConstants::INVALID_INDEX) {
+					return 0;
+				}
+				return lstate.field_lookup[schema_col] + 1;
+			};
+			lstate.max_needed_fields = 0;
+			for (auto &converter : gstate.converters) {
+				lstate.max_needed_fields =
+				    MaxValue<idx_t>(lstate.max_needed_fields, needed_fields(converter.schema_col));
+			}
+			lstate.filter_fields = lstate.max_needed_fields;
+			if (!gstate.column_filters.empty() && !lstate.json) {
+				lstate.filter_fields = 0;
+				for (auto &entry : gstate.column_filters) {
+					lstate.filter_fields = MaxValue<idx_t>(lstate.filter_fields, needed_fields(entry.schema_col));
+				}
+			}
+
+			lstate.resume_offset = 0;
+			if (bind_data.tail) {
+				lstate.current_log_id = LogId(file_header, lstate.current_file_path);
+				auto since_entry = bind_data.since_offsets.find(lstate.current_log_id);
+				if (since_entry != bind_data.since_offsets.end()) {
+					lstate.resume_offset = since_entry->second;
+				}
+				// A log that got shorter than where it was left has been replaced, and is read in full.
+				if (!ZeekReader::IsCompressedPath(lstate.current_file_path) && lstate.file_handle->CanSeek() &&
+				    lstate.resume_offset > lstate.file_handle->GetFileSize()) {
+					lstate.resume_offset = 0;
+				}
+			}
+
+			// A unit that does not start the file resyncs to the first line boundary after its start
+			// by discarding bytes through the first newline; the line in progress at `start` belongs
+			// to the previous unit. Uncompressed files resume the same way, from the newline ending
+			// the line before the resume offset; compressed streams are read up to it.
+			const idx_t resume_start = lstate.resume_offset > 0 ? lstate.resume_offset - 1 : 0;
+			if (lstate.blocks) {
+				lstate.unit_block_end = unit.end;
+				if (unit.start > 0) {
+					for (idx_t i = 0; i < unit.start; i++) {
+						lstate.unit_stream_offset += (*lstate.blocks)[i].decompressed_size;
+					}
+					lstate.next_block = unit.start;
+					ResetReadBuffer(lstate, 0);
+					ReadLineBuffered(lstate);
+				}
+			} else if (unit.IsRange()) {
+				// The last range of a file reads on to its end, in case it grew since bind sized it.
+				lstate.range_end = unit.end == bind_data.file_sizes[my_file_idx] ? DConstants::INVALID_INDEX : unit.end;
+				const idx_t start = MaxValue<idx_t>(unit.start, resume_start);
+				if (start >= unit.end) {
+					// Every line of the unit precedes the resume offset.
+					CloseCurrentFile(lstate);
+					continue;
+				}
+				if (start > 0) {
+					lstate.file_handle->Seek(start);
+					ResetReadBuffer(lstate, start);
+					ReadLineBuffered(lstate);
+				}
+			} else if (resume_start > 0 && !ZeekReader::IsCompressedPath(lstate.current_file_path) &&
+			           lstate.file_handle->CanSeek()) {
+				lstate.file_handle->Seek(resume_start);
+				ResetReadBuffer(lstate, resume_start);
+				ReadLineBuffered(lstate);
+			}
+			lstate.counters.scan_units++;
 			return true;
 		} catch (const std::exception &e) {
 			// If ignore_file_errors is enabled, skip this file and try the next one.
 			// Otherwise, re-throw the exception to fail the query.
 			if (bind_data.ignore_file_errors) {
-				// Close any partially-opened file handle and continue to the next file.
-				lstate.file_handle.reset();
+				// Close any partially-opened file handle and continue to the next file, which leaves
+				// this one unwritten.
+				lstate.counters.files_skipped++;
+				CloseCurrentFile(lstate);
+				if (gstate.parquet_writer) {
+					gstate.parquet_writer->AbandonUnit(my_file_idx);
+				}
 				continue;
 			} else {
 				throw;
@@ -329,164 +920,398 @@ static bool OpenNextFile(ClientContext &context, ZeekScanGlobalState &gstate, Ze
 	}
 }
 
-static void AppendListValue(ClientContext &context, ZeekScanLocalState &lstate, Vector &vec, idx_t row_idx,
-                            const FieldSlice &field, char set_separator, const LogicalType &child_type,
-                            const string &unset_field, const string &empty_field) {
-	auto &list_entry = ListVector::GetData(vec)[row_idx];
-	auto current_size = ListVector::GetListSize(vec);
-
-	if (SliceEquals(field, unset_field) || SliceEquals(field, empty_field)) {
-		list_entry.offset = current_size;
-		list_entry.length = 0;
-		return;
+//! True if `field` is one of the header's unset and empty markers. With DEFAULT_MARKERS (every file is
+//! a TSV log using Zeek's "-" and "(empty)") the comparison is against constants.
+template <bool DEFAULT_MARKERS>
+static inline bool IsNullMarker(const ZeekHeader &header, const FieldSlice &field) {
+	if (DEFAULT_MARKERS) {
+		return (field.len == 1 && field.ptr[0] == '-') ||
+		       (field.len == 7 && std::memcmp(field.ptr, "(empty)", 7) == 0);
 	}
+	return SliceEquals(field, header.unset_field) || SliceEquals(field, header.empty_field);
+}
 
-	TokenizeSpan(field.ptr, field.len, set_separator, lstate.list_element_slices);
-	auto &elements = lstate.list_element_slices;
-
-	list_entry.offset = current_size;
-	list_entry.length = elements.size();
-
-	auto &child_vec = ListVector::GetEntry(vec);
-	ListVector::Reserve(vec, current_size + elements.size());
-	ListVector::SetListSize(vec, current_size + elements.size());
+// Writers of a non-NULL field to row `row` of a vector of their type. A field that doesn't parse is
+// NULL.
 
-	auto child_type_id = child_type.id();
-	for (idx_t i = 0; i < elements.size(); i++) {
-		idx_t child_idx = current_size + i;
-		const FieldSlice &elem = elements[i];
+struct VarcharWriter {
+	static void Write(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field) {
+		WriteStringField(input, vec, row, field);
+	}
+};
 
-		if (SliceEquals(elem, unset_field) || SliceEquals(elem, empty_field)) {
-			FlatVector::SetNull(child_vec, child_idx, true);
-			continue;
+template <class T>
+struct NumericWriter {
+	static void Write(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field) {
+		if (!TryCast::Operation<string_t, T>(string_t(field.ptr, field.len), FlatVector::GetData<T>(vec)[row])) {
+			FlatVector::SetNull(vec, row, true);
 		}
+	}
+};
 
-		string_t elem_str(elem.ptr, elem.len);
+struct BooleanWriter {
+	static void Write(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field) {
+		FlatVector::GetData<bool>(vec)[row] =
+		    (field.len == 1 && field.ptr[0] == 'T') || (field.len == 4 && std::memcmp(field.ptr, "true", 4) == 0);
+	}
+};
 
-		switch (child_type_id) {
-		case LogicalTypeId::DOUBLE: {
-			double val;
-			if (TryCast::Operation<string_t, double>(elem_str, val)) {
-				FlatVector::GetData<double>(child_vec)[child_idx] = val;
-			} else {
-				FlatVector::SetNull(child_vec, child_idx, true);
-			}
-			break;
-		}
-		case LogicalTypeId::UBIGINT: {
-			uint64_t val;
-			if (TryCast::Operation<string_t, uint64_t>(elem_str, val)) {
-				FlatVector::GetData<uint64_t>(child_vec)[child_idx] = val;
-			} else {
-				FlatVector::SetNull(child_vec, child_idx, true);
-			}
-			break;
-		}
-		case LogicalTypeId::BIGINT: {
-			int64_t val;
-			if (TryCast::Operation<string_t, int64_t>(elem_str, val)) {
-				FlatVector::GetData<int64_t>(child_vec)[child_idx] = val;
-			} else {
-				FlatVector::SetNull(child_vec, child_idx, true);
-			}
-			break;
-		}
-		case LogicalTypeId::BOOLEAN: {
-			FlatVector::GetData<bool>(child_vec)[child_idx] =
-			    (elem.len == 1 && elem.ptr[0] == 'T') || (elem.len == 4 && std::memcmp(elem.ptr, "true", 4) == 0);
-			break;
-		}
-		case LogicalTypeId::TIMESTAMP_TZ: {
-			double val;
-			if (TryCast::Operation<string_t, double>(elem_str, val)) {
-				FlatVector::GetData<timestamp_tz_t>(child_vec)[child_idx] = EpochSecondsToTimestampTZ(val);
-			} else {
-				FlatVector::SetNull(child_vec, child_idx, true);
-			}
-			break;
-		}
-		case LogicalTypeId::INTERVAL: {
-			double val;
-			if (TryCast::Operation<string_t, double>(elem_str, val)) {
-				FlatVector::GetData<interval_t>(child_vec)[child_idx] = SecondsToInterval(val);
-			} else {
-				FlatVector::SetNull(child_vec, child_idx, true);
-			}
-			break;
-		}
-		case LogicalTypeId::USMALLINT: {
-			uint16_t val;
-			if (TryCast::Operation<string_t, uint16_t>(elem_str, val)) {
-				FlatVector::GetData<uint16_t>(child_vec)[child_idx] = val;
-			} else {
-				FlatVector::SetNull(child_vec, child_idx, true);
-			}
-			break;
-		}
-		case LogicalTypeId::VARCHAR: {
-			FlatVector::GetData<string_t>(child_vec)[child_idx] =
-			    StringVector::AddString(child_vec, elem.ptr, elem.len);
-			break;
-		}
-		default: {
-			child_vec.SetValue(child_idx, Value(string(elem.ptr, elem.len)).CastAs(context, child_type));
-			break;
-		}
+struct TimeWriter {
+	static void Write(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field) {
+		if (!ZeekReader::TryParseTime(field.ptr, field.len, FlatVector::GetData<timestamp_tz_t>(vec)[row])) {
+			FlatVector::SetNull(vec, row, true);
 		}
 	}
-}
-
-static unique_ptr<FunctionData> ZeekScanBind(ClientContext &context, TableFunctionBindInput &input,
-                                             vector<LogicalType> &return_types, vector<string> &names) {
-	auto result = make_uniq<ZeekScanBindData>();
-	string pattern = input.inputs[0].GetValue<string>();
-
-	auto &fs = FileSystem::GetFileSystem(context);
+};
 
-	auto glob_result = fs.Glob(pattern);
-	if (glob_result.empty()) {
-		throw IOException("No files found matching pattern: %s", pattern);
-	}
-	for (auto &file_info : glob_result) {
-		result->file_paths.push_back(file_info.path);
+struct IntervalWriter {
+	static void Write(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field) {
+		if (!ZeekReader::TryParseInterval(field.ptr, field.len, FlatVector::GetData<interval_t>(vec)[row])) {
+			FlatVector::SetNull(vec, row, true);
+		}
 	}
-	std::sort(result->file_paths.begin(), result->file_paths.end());
-
-	auto filename_param = input.named_parameters.find("filename");
-	if (filename_param != input.named_parameters.end()) {
-		result->filename_column = filename_param->second.GetValue<bool>();
+};
+
+//! Natively decoded INET; anything Parse rejects goes through the extension's cast.
+struct InetWriter {
+	static void Write(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field) {
+		ZeekInetAddress address;
+		if (ZeekInet::Parse(field.ptr, field.len, address)) {
+			ZeekInet::Write(vec, row, address);
+		} else {
+			vec.SetValue(row, Value(string(field.ptr, field.len)).CastAs(input.context, vec.GetType()));
+		}
 	}
+};
 
-	bool replace_periods = true;
-	auto replace_periods_param = input.named_parameters.find("replace_periods");
-	if (replace_periods_param != input.named_parameters.end()) {
-		replace_periods = replace_periods_param->second.GetValue<bool>();
+//! Columns that aren't handled natively: the field is collected in the column's VARCHAR temp vector,
+//! which is batch-cast to the real type at the end of the chunk.
+struct CastBufferWriter {
+	static void Write(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field) {
+		FlatVector::GetData<string_t>(vec)[row] = StringVector::AddString(vec, field.ptr, field.len);
 	}
+};
 
-	auto inet_param = input.named_parameters.find("inet");
-	if (inet_param != input.named_parameters.end()) {
-		result->use_inet = inet_param->second.GetValue<bool>();
+//! List elements of types that aren't handled natively, cast one by one.
+struct CastValueWriter {
+	static void Write(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field) {
+		vec.SetValue(row, Value(string(field.ptr, field.len)).CastAs(input.context, vec.GetType()));
 	}
+};
 
-	auto union_by_name_param = input.named_parameters.find("union_by_name");
-	if (union_by_name_param != input.named_parameters.end()) {
-		result->union_by_name = union_by_name_param->second.GetValue<bool>();
-	}
+struct ListWriter {
+	static void Write(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field);
+};
 
-	auto ignore_file_errors_param = input.named_parameters.find("ignore_file_errors");
-	if (ignore_file_errors_param != input.named_parameters.end()) {
-		result->ignore_file_errors = ignore_file_errors_param->second.GetValue<bool>();
+//! A ZeekFieldConverter: NULL for the null markers, else WRITER's value.
+template <class WRITER, bool DEFAULT_MARKERS>
+static void ConvertField(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field) {
+	if (IsNullMarker<DEFAULT_MARKERS>(*input.lstate.markers, field)) {
+		FlatVector::SetNull(vec, row, true);
+		return;
 	}
+	WRITER::Write(input, vec, row, field);
+}
 
-	if (!result->union_by_name) {
-		// Strict mode: parse only the first file's header. Per-file validation happens at scan time.
+//! The converter for fields (or list elements) of `type`.
+template <bool DEFAULT_MARKERS>
+static ZeekFieldConverter SelectConverter(const LogicalType &type, bool native_inet) {
+	switch (type.id()) {
+	case LogicalTypeId::VARCHAR:
+		return ConvertField<VarcharWriter, DEFAULT_MARKERS>;
+	case LogicalTypeId::DOUBLE:
+		return ConvertField<NumericWriter<double>, DEFAULT_MARKERS>;
+	case LogicalTypeId::UBIGINT:
+		return ConvertField<NumericWriter<uint64_t>, DEFAULT_MARKERS>;
+	case LogicalTypeId::BIGINT:
+		return ConvertField<NumericWriter<int64_t>, DEFAULT_MARKERS>;
+	case LogicalTypeId::USMALLINT:
+		return ConvertField<NumericWriter<uint16_t>, DEFAULT_MARKERS>;
+	case LogicalTypeId::BOOLEAN:
+		return ConvertField<BooleanWriter, DEFAULT_MARKERS>;
+	case LogicalTypeId::TIMESTAMP_TZ:
+		return ConvertField<TimeWriter, DEFAULT_MARKERS>;
+	case LogicalTypeId::INTERVAL:
+		return ConvertField<IntervalWriter, DEFAULT_MARKERS>;
+	case LogicalTypeId::LIST:
+		return ConvertField<ListWriter, DEFAULT_MARKERS>;
+	case LogicalTypeId::STRUCT:
+		if (native_inet && ZeekInet::IsInetType(type)) {
+			return ConvertField<InetWriter, DEFAULT_MARKERS>;
+		}
+		return ConvertField<CastValueWriter, DEFAULT_MARKERS>;
+	default:
+		return ConvertField<CastValueWriter, DEFAULT_MARKERS>;
+	}
+}
+
+//! Resolve how the output column of schema column `schema_col` is filled. A scan that writes Parquet
+//! converts data columns to their varchar_inet_types.
+static ZeekColumnConverter MakeColumnConverter(const ZeekScanBindData &bind_data, column_t schema_col) {
+	ZeekColumnConverter converter;
+	converter.schema_col = schema_col;
+	const idx_t data_col_count = bind_data.column_types.size();
+	if (schema_col >= data_col_count) {
+		if (bind_data.filename_column && schema_col == data_col_count) {
+			converter.source = ZeekColumnConverter::Source::FILENAME;
+		} else if (schema_col == bind_data.log_id_column) {
+			converter.source = ZeekColumnConverter::Source::LOG_ID;
+		} else if (schema_col == bind_data.sample_weight_column) {
+			converter.source = ZeekColumnConverter::Source::SAMPLE_WEIGHT;
+		} else {
+			converter.source = ZeekColumnConverter::Source::NEXT_OFFSET;
+		}
+		return converter;
+	}
+	const bool default_markers =
+	    !bind_data.json_files && bind_data.header.unset_field == "-" && bind_data.header.empty_field == "(empty)";
+	auto select = default_markers ? SelectConverter<true> : SelectConverter<false>;
+	auto &type =
+	    bind_data.WritesParquet() ? bind_data.varchar_inet_types[schema_col] : bind_data.column_types[schema_col];
+	auto cast_buffer_writer =
+	    default_markers ? ConvertField<CastBufferWriter, true> : ConvertField<CastBufferWriter, false>;
+	if (type.id() == LogicalTypeId::LIST) {
+		converter.convert = select(type, bind_data.native_inet);
+		auto &child_type = ListType::GetChildType(type);
+		if (IsNativelyHandled(child_type, bind_data.native_inet)) {
+			converter.convert_element = select(child_type, bind_data.native_inet);
+		} else {
+			// Elements without a native converter are collected in a LIST(VARCHAR) vector, which is
+			// cast as a whole at the end of the chunk.
+			converter.cast_buffer = true;
+			converter.cast_type = LogicalType::LIST(LogicalType::VARCHAR);
+			converter.convert_element = cast_buffer_writer;
+		}
+		return converter;
+	}
+	if (!IsNativelyHandled(type, bind_data.native_inet)) {
+		converter.cast_buffer = true;
+		converter.convert = cast_buffer_writer;
+		return converter;
+	}
+	converter.convert = select(type, bind_data.native_inet);
+	return converter;
+}
+
+//! Append the elements of a set/vector `field` (not a null marker) as the list in row `row` of `vec`.
+//! The elements are counted first, so that the child vector grows (if at all) once per row, and are
+//! then converted as they are split off.
+void ListWriter::Write(ZeekConvertInput &input, Vector &vec, idx_t row, const FieldSlice &field) {
+	const char separator = input.lstate.json ? ZeekJson::LIST_SEPARATOR : input.bind_data.header.set_separator;
+	const idx_t element_count = ZeekTokenizer::CountSeparators(field.ptr, field.len, separator) + 1;
+
+	auto &list_entry = ListVector::GetData(vec)[row];
+	const auto current_size = ListVector::GetListSize(vec);
+	list_entry.offset = current_size;
+	list_entry.length = element_count;
+
+	ListVector::Reserve(vec, current_size + element_count);
+	ListVector::SetListSize(vec, current_size + element_count);
+	auto &child_vec = ListVector::GetEntry(vec);
+	const auto convert_element = input.column->convert_element;
+	const char *element = field.ptr;
+	const char *field_end = field.ptr + field.len;
+	for (idx_t i = 0; i + 1 < element_count; i++) {
+		auto element_end = static_cast<const char *>(std::memchr(element, separator, field_end - element));
+		convert_element(input, child_vec, current_size + i,
+		                {element, static_cast<uint32_t>(element_end - element)});
+		element = element_end + 1;
+	}
+	convert_element(input, child_vec, current_size + element_count - 1,
+	                {element, static_cast<uint32_t>(field_end - element)});
+}
+
+//! Size the scan for the cardinality estimate (see ZeekScanBindData::estimated_scan_bytes) from the
+//! file sizes bind found.
+static void EstimateScanSize(ZeekScanBindData &bind_data) {
+	idx_t sized_files = 0;
+	idx_t unsized_files = 0;
+	for (idx_t file_idx = 0; file_idx < bind_data.file_paths.size(); file_idx++) {
+		auto &index = bind_data.file_indexes[file_idx];
+		if (index) {
+			bind_data.indexed_rows += index->RowCount();
+			continue;
+		}
+		const idx_t size = bind_data.file_sizes[file_idx];
+		if (size == DConstants::INVALID_INDEX) {
+			unsized_files++;
+			continue;
+		}
+		const bool compressed = ZeekReader::IsCompressedPath(bind_data.file_paths[file_idx]);
+		bind_data.estimated_scan_bytes += compressed ? size * COMPRESSION_RATIO_ESTIMATE : size;
+		sized_files++;
+	}
+	if (unsized_files > 0) {
+		if (sized_files == 0) {
+			bind_data.scan_bytes_known = false;
+			return;
+		}
+		bind_data.estimated_scan_bytes += bind_data.estimated_scan_bytes / sized_files * unsized_files;
+	}
+}
+
+//! Fill bind_data.file_sizes from the files' indexes and the headers bind parsed, and stat the other
+//! files in parallel, except for remote compressed ones.
+static void SizeFiles(ClientContext &context, ZeekScanBindData &bind_data) {
+	auto &sizes = bind_data.file_sizes;
+	sizes.assign(bind_data.file_paths.size(), DConstants::INVALID_INDEX);
+	vector<idx_t> unsized_files;
+	for (idx_t file_idx = 0; file_idx < bind_data.file_paths.size(); file_idx++) {
+		const string &path = bind_data.file_paths[file_idx];
+		if (bind_data.file_indexes[file_idx]) {
+			sizes[file_idx] = bind_data.file_indexes[file_idx]->source_size;
+		} else if (bind_data.file_headers[file_idx]) {
+			sizes[file_idx] = bind_data.file_headers[file_idx]->source_size;
+		} else if (!ZeekReader::IsCompressedPath(path) || !FileSystem::IsRemoteFile(path)) {
+			unsized_files.push_back(file_idx);
+		}
+	}
+	ZeekHeaderCache::GetFileSizes(context, bind_data.file_paths, unsized_files, sizes);
+}
+
+vector<string> ZeekScan::GlobFiles(FileSystem &fs, const Value &files) {
+	vector<string> patterns;
+	if (files.type().id() == LogicalTypeId::LIST) {
+		for (auto &pattern : ListValue::GetChildren(files)) {
+			if (pattern.IsNull()) {
+				throw InvalidInputException("read_zeek: the list of files can't contain NULL");
+			}
+			patterns.push_back(pattern.GetValue<string>());
+		}
+	} else {
+		patterns.push_back(files.GetValue<string>());
+	}
+	vector<string> file_paths;
+	for (auto &pattern : patterns) {
+		for (auto &file_info : fs.Glob(pattern)) {
+			if (!ZeekIndex::IsSidecarPath(file_info.path)) {
+				file_paths.push_back(file_info.path);
+			}
+		}
+	}
+	if (file_paths.empty()) {
+		throw IOException("No files found matching pattern: %s", files.ToString());
+	}
+	// Globs of a list may overlap; each file is read once.
+	std::sort(file_paths.begin(), file_paths.end());
+	file_paths.erase(std::unique(file_paths.begin(), file_paths.end()), file_paths.end());
+	return file_paths;
+}
+
+unique_ptr<ZeekScanBindData> ZeekScan::Bind(ClientContext &context, const Value &files,
+                                             const named_parameter_map_t &parameters, bool separate_types,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<ZeekScanBindData>();
+	const string pattern = files.ToString();
+	result->pattern = pattern;
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	result->file_paths = GlobFiles(fs, files);
+
+	auto filename_param = parameters.find("filename");
+	if (filename_param != parameters.end()) {
+		result->filename_column = filename_param->second.GetValue<bool>();
+	}
+
+	bool replace_periods = true;
+	auto replace_periods_param = parameters.find("replace_periods");
+	if (replace_periods_param != parameters.end()) {
+		replace_periods = replace_periods_param->second.GetValue<bool>();
+	}
+
+	auto inet_param = parameters.find("inet");
+	if (inet_param != parameters.end()) {
+		result->use_inet = inet_param->second.GetValue<bool>();
+	}
+
+	auto union_by_name_param = parameters.find("union_by_name");
+	if (union_by_name_param != parameters.end()) {
+		result->union_by_name = union_by_name_param->second.GetValue<bool>();
+	}
+
+	auto ignore_file_errors_param = parameters.find("ignore_file_errors");
+	if (ignore_file_errors_param != parameters.end()) {
+		result->ignore_file_errors = ignore_file_errors_param->second.GetValue<bool>();
+	}
+
+	auto zero_copy_param = parameters.find("zero_copy");
+	if (zero_copy_param != parameters.end()) {
+		result->zero_copy = zero_copy_param->second.GetValue<bool>();
+	}
+
+	auto ts_lag_param = parameters.find("ts_lag");
+	if (ts_lag_param != parameters.end() && !ts_lag_param->second.IsNull()) {
+		result->ts_lag = ts_lag_param->second.GetValue<interval_t>();
+		result->has_ts_lag = true;
+	}
+
+	auto ts_lead_param = parameters.find("ts_lead");
+	if (ts_lead_param != parameters.end() && !ts_lead_param->second.IsNull()) {
+		result->ts_lead = ts_lead_param->second.GetValue<interval_t>();
+		result->has_ts_lead = true;
+	}
+
+	auto parallel_decompression_param = parameters.find("parallel_decompression");
+	if (parallel_decompression_param != parameters.end()) {
+		result->parallel_decompression = parallel_decompression_param->second.GetValue<bool>();
+	}
+
+	auto buffer_size_param = parameters.find("buffer_size");
+	if (buffer_size_param != parameters.end() && !buffer_size_param->second.IsNull()) {
+		result->buffer_size = buffer_size_param->second.GetValue<uint64_t>();
+		if (result->buffer_size < MIN_READ_BUFFER_SIZE || result->buffer_size > MAX_READ_BUFFER_SIZE) {
+			throw InvalidInputException("read_zeek: buffer_size must be between %llu and %llu bytes",
+			                            MIN_READ_BUFFER_SIZE, MAX_READ_BUFFER_SIZE);
+		}
+	}
+
+	// Sidecar indexes are looked for next to local files by default; remote files only on request, as
+	// probing for them costs a request per file.
+	bool use_index_explicit = false;
+	auto use_index_param = parameters.find("use_index");
+	if (use_index_param != parameters.end()) {
+		result->use_index = use_index_param->second.GetValue<bool>();
+		use_index_explicit = true;
+	}
+	// Tail mode resumes each log from an offset the previous call returned. Indexes describe whole files,
+	// so they aren't used.
+	auto since_param = parameters.find("since");
+	if (since_param != parameters.end() && !since_param->second.IsNull()) {
+		result->tail = true;
+		result->use_index = false;
+		for (auto &since_entry : MapValue::GetChildren(since_param->second)) {
+			auto &key_value = StructValue::GetChildren(since_entry);
+			if (key_value[0].IsNull() || key_value[1].IsNull()) {
+				throw InvalidInputException("read_zeek: since must map log ids to offsets, without NULLs");
+			}
+			result->since_offsets[key_value[0].GetValue<string>()] = key_value[1].GetValue<uint64_t>();
+		}
+	}
+	auto sample_param = parameters.find("sample");
+	if (sample_param != parameters.end() && !sample_param->second.IsNull()) {
+		result->sample = sample_param->second.GetValue<double>();
+		if (!(result->sample > 0 && result->sample <= 1)) {
+			throw InvalidInputException("read_zeek: sample must be greater than 0 and at most 1");
+		}
+		if (result->tail) {
+			throw InvalidInputException("read_zeek: sample can't be combined with since");
+		}
+	}
+	if (result->use_index) {
+		result->file_indexes = ZeekIndex::LoadAll(fs, result->file_paths, use_index_explicit);
+	} else {
+		result->file_indexes.resize(result->file_paths.size());
+	}
+	result->file_headers.resize(result->file_paths.size());
+	if (!result->union_by_name) {
+		// Strict mode: parse only the first file's header. Per-file validation happens at scan time.
 		// If ignore_file_errors is enabled, try each file until we find one that works.
 		bool found_valid_file = false;
 		for (idx_t file_idx = 0; file_idx < result->file_paths.size(); file_idx++) {
 			try {
-				auto file_handle = fs.OpenFile(result->file_paths[file_idx],
-				                               FileFlags::FILE_FLAGS_READ | FileCompressionType::AUTO_DETECT);
-				result->header = ZeekReader::ParseHeader(*file_handle);
+				result->file_headers[file_idx] = ZeekHeaderCache::GetHeader(context, result->file_paths[file_idx]);
+				result->header = *result->file_headers[file_idx];
+				result->json_files = result->header.json;
 				found_valid_file = true;
 				break;
 			} catch (const std::exception &e) {
@@ -506,27 +1331,31 @@ static unique_ptr<FunctionData> ZeekScanBind(ClientContext &context, TableFuncti
 	} else {
 		// Union mode: open every file, parse its header, build the union schema and per-file
 		// inverse mappings. Same field name + different Zeek type → bind-time error.
+		// The headers are read in parallel; merging them in file order keeps the union schema and
+		// error reporting deterministic.
+		vector<ErrorData> header_errors;
+		ZeekHeaderCache::GetHeaders(context, result->file_paths, result->file_headers, header_errors);
+
 		vector<vector<idx_t>> file_field_to_union(result->file_paths.size());
 		std::unordered_map<string, idx_t> name_to_union_idx;
 		bool first_file = true;
 
 		for (idx_t file_idx = 0; file_idx < result->file_paths.size(); file_idx++) {
-			ZeekHeader file_header;
-			try {
-				auto file_handle = fs.OpenFile(result->file_paths[file_idx],
-				                               FileFlags::FILE_FLAGS_READ | FileCompressionType::AUTO_DETECT);
-				file_header = ZeekReader::ParseHeader(*file_handle);
-			} catch (const std::exception &e) {
+			if (header_errors[file_idx].HasError()) {
 				if (!result->ignore_file_errors) {
-					throw;
+					header_errors[file_idx].Throw();
 				}
 				// Skip this corrupted file - mark it as having no fields so OpenNextFile will also skip it
 				file_field_to_union[file_idx].clear();
 				continue;
 			}
+			const ZeekHeader &file_header = *result->file_headers[file_idx];
 
-			if (first_file) {
-				// Use file 0's separators / null markers as the canonical settings.
+			if (file_header.json) {
+				// JSON logs have no separators, and their fields are compared against their own markers.
+				result->json_files = true;
+			} else if (first_file) {
+				// Use the first TSV file's separators / null markers as the canonical settings.
 				result->header.separator = file_header.separator;
 				result->header.set_separator = file_header.set_separator;
 				result->header.unset_field = file_header.unset_field;
@@ -548,13 +1377,15 @@ static unique_ptr<FunctionData> ZeekScanBind(ClientContext &context, TableFuncti
 			for (idx_t f = 0; f < file_header.fields.size(); f++) {
 				const string &fname = file_header.fields[f];
 				const string &ftype = file_header.types[f];
+				// With separate_types, each of a field's types gets a column of its own.
+				const string key = separate_types ? fname + '\t' + ftype : fname;
 
-				auto it = name_to_union_idx.find(fname);
+				auto it = name_to_union_idx.find(key);
 				if (it == name_to_union_idx.end()) {
 					idx_t new_union_idx = result->header.fields.size();
 					result->header.fields.push_back(fname);
 					result->header.types.push_back(ftype);
-					name_to_union_idx[fname] = new_union_idx;
+					name_to_union_idx[key] = new_union_idx;
 					file_field_to_union[file_idx][f] = new_union_idx;
 				} else {
 					idx_t existing = it->second;
@@ -589,6 +1420,16 @@ static unique_ptr<FunctionData> ZeekScanBind(ClientContext &context, TableFuncti
 		}
 	}
 
+	// A scan with cache_dir is only bound for logs the cache has none of (see ZeekCache::BindReplace),
+	// which it writes to the cache as it reads them.
+	auto cache_dir_param = parameters.find("cache_dir");
+	if (cache_dir_param != parameters.end() && !cache_dir_param->second.IsNull()) {
+		ZeekCache::BindWriteThrough(context, cache_dir_param->second.GetValue<string>(), replace_periods, *result);
+	}
+
+	SizeFiles(context, *result);
+	EstimateScanSize(*result);
+
 	for (idx_t i = 0; i < result->header.fields.size(); i++) {
 		string col_name = result->header.fields[i];
 		if (replace_periods) {
@@ -598,330 +1439,894 @@ static unique_ptr<FunctionData> ZeekScanBind(ClientContext &context, TableFuncti
 		LogicalType col_type = ZeekReader::ZeekTypeToDuckDBType(result->header.types[i], result->use_inet, &context);
 		return_types.push_back(col_type);
 		result->column_types.push_back(col_type);
+		result->varchar_inet_types.push_back(ZeekReader::ZeekTypeToDuckDBType(result->header.types[i], false));
+	}
+	result->column_names = names;
+
+	// Zeek enums have a handful of values; other low-cardinality strings can be named explicitly.
+	result->dictionary_columns.resize(result->column_types.size(), false);
+	for (idx_t i = 0; i < result->header.types.size(); i++) {
+		result->dictionary_columns[i] = result->header.types[i] == "enum";
+	}
+	auto dictionary_columns_param = parameters.find("dictionary_columns");
+	if (dictionary_columns_param != parameters.end() && !dictionary_columns_param->second.IsNull()) {
+		for (auto &name_value : ListValue::GetChildren(dictionary_columns_param->second)) {
+			auto name = name_value.ToString();
+			auto it = std::find(names.begin(), names.end(), name);
+			if (name_value.IsNull() || it == names.end()) {
+				throw InvalidInputException("read_zeek: dictionary_columns names unknown column '%s'", name);
+			}
+			idx_t col_idx = NumericCast<idx_t>(it - names.begin());
+			if (result->column_types[col_idx].id() != LogicalTypeId::VARCHAR) {
+				throw InvalidInputException("read_zeek: dictionary_columns column '%s' is not a VARCHAR column", name);
+			}
+			result->dictionary_columns[col_idx] = true;
+		}
+	}
+
+	// Decode INET natively only if the loaded inet extension still uses the layout we write.
+	if (result->use_inet) {
+		for (auto &col_type : result->column_types) {
+			auto &inet_type = col_type.id() == LogicalTypeId::LIST ? ListType::GetChildType(col_type) : col_type;
+			if (ZeekInet::IsInetType(inet_type)) {
+				result->native_inet = ZeekInet::SupportsNativeDecoding(context, inet_type);
+				break;
+			}
+		}
 	}
 
 	if (result->filename_column) {
 		names.push_back("filename");
 		return_types.push_back(LogicalType::VARCHAR);
 	}
+	if (result->tail) {
+		result->log_id_column = names.size();
+		names.push_back("log_id");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.push_back("next_offset");
+		return_types.push_back(LogicalType::UBIGINT);
+	}
+	if (result->sample < 1) {
+		result->sample_weight_column = names.size();
+		names.push_back("sample_weight");
+		return_types.push_back(LogicalType::DOUBLE);
+	}
 
-	return std::move(result);
+	return result;
 }
 
-static unique_ptr<GlobalTableFunctionState> ZeekScanInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
-	auto &bind_data = input.bind_data->Cast<ZeekScanBindData>();
-	auto result = make_uniq<ZeekScanGlobalState>();
-
-	result->total_files = bind_data.file_paths.size();
+static unique_ptr<FunctionData> ZeekScanBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	return ZeekScan::Bind(context, input.inputs[0], input.named_parameters, false, return_types, names);
+}
 
-	// Resolve projection: which schema columns does the query actually want?
-	// column_ids is provided by DuckDB when projection_pushdown = true.
-	// An empty column_ids means COUNT(*) — no columns needed at all.
-	if (input.column_ids.empty()) {
-		result->count_only = true;
-	} else {
-		for (auto &col_id : input.column_ids) {
-			result->projected_schema_cols.push_back(col_id);
+//! The pushed-down filter on the `ts` column (Zeek's record timestamp), if any.
+static optional_ptr<const TableFilter> FindTimestampFilter(const ZeekScanBindData &bind_data,
+                                                           const ZeekScanGlobalState &gstate) {
+	if (!gstate.filters) {
+		return nullptr;
+	}
+	for (auto &entry : gstate.filters->filters) {
+		column_t schema_col = gstate.projected_schema_cols[entry.first];
+		if (schema_col < bind_data.column_types.size() && bind_data.header.fields[schema_col] == "ts" &&
+		    bind_data.column_types[schema_col].id() == LogicalTypeId::TIMESTAMP_TZ) {
+			return entry.second.get();
 		}
 	}
+	return nullptr;
+}
 
-	// For each projected column, decide whether it needs the batched cast path. Threads will
-	// each allocate their own temp vectors based on this list.
-	const idx_t data_col_count = bind_data.column_types.size();
-	result->needs_cast_buffer.resize(result->projected_schema_cols.size(), false);
-	for (idx_t out_idx = 0; out_idx < result->projected_schema_cols.size(); out_idx++) {
-		column_t schema_col = result->projected_schema_cols[out_idx];
-		if (bind_data.filename_column && schema_col == data_col_count) {
-			continue;
+//! Returns false if `ts_filter` rules out every row of the index entry. `null_passes` is the filter's
+//! result on a NULL ts.
+static bool IndexEntryMayMatch(const ZeekIndexEntry &entry, const TableFilter &ts_filter, bool null_passes) {
+	if (entry.ts_count < entry.row_count && null_passes) {
+		return true;
+	}
+	if (entry.ts_count == 0) {
+		return false;
+	}
+	auto stats = BaseStatistics::CreateUnknown(LogicalType::TIMESTAMP_TZ);
+	stats.Set(StatsInfo::CANNOT_HAVE_NULL_VALUES);
+	NumericStats::SetMin(stats, Value::TIMESTAMPTZ(timestamp_tz_t(entry.min_ts)));
+	NumericStats::SetMax(stats, Value::TIMESTAMPTZ(timestamp_tz_t(entry.max_ts)));
+	return ts_filter.CheckStatistics(stats) != FilterPropagateResult::FILTER_ALWAYS_FALSE;
+}
+
+//! Append scan units for only the entries of the file's index that `ts_filter` may match, merging
+//! adjacent entries into units of about SCAN_RANGE_SIZE bytes. Returns false, adding nothing, if no
+//! entry is ruled out (or the index can't be used), so that the file is split as usual.
+static bool AddIndexedScanUnits(FileSystem &fs, const ZeekScanBindData &bind_data, idx_t file_idx,
+                                const ZeekFileIndex &index, const TableFilter &ts_filter, bool null_passes,
+                                ZeekScanGlobalState &gstate) {
+	auto &entries = index.entries;
+	vector<bool> may_match(entries.size());
+	bool any_ruled_out = false;
+	for (idx_t i = 0; i < entries.size(); i++) {
+		may_match[i] = IndexEntryMayMatch(entries[i], ts_filter, null_passes);
+		any_ruled_out = any_ruled_out || !may_match[i];
+	}
+	if (!any_ruled_out) {
+		return false;
+	}
+	if (index.layout == ZeekIndexLayout::STREAM) {
+		// The single entry of a stream is ruled out: skip the file.
+		return true;
+	}
+
+	ZeekBlockFormat unit_format = ZeekBlockFormat::NONE;
+	auto &blocks = gstate.file_blocks[file_idx];
+	if (index.layout == ZeekIndexLayout::BLOCK_RUNS) {
+		try {
+			auto handle = fs.OpenFile(bind_data.file_paths[file_idx], FileFlags::FILE_FLAGS_READ);
+			unit_format = ZeekBlockCodec::DetectBlocks(*handle, blocks);
+		} catch (const std::exception &e) {
+			unit_format = ZeekBlockFormat::NONE;
 		}
-		if (schema_col >= data_col_count) {
+		if (unit_format != index.block_format || blocks.size() != entries.back().end) {
+			blocks.clear();
+			return false;
+		}
+	}
+
+	for (idx_t i = 0; i < entries.size();) {
+		if (!may_match[i]) {
+			i++;
 			continue;
 		}
-		if (!IsNativelyHandled(bind_data.column_types[schema_col])) {
-			result->needs_cast_buffer[out_idx] = true;
+		const idx_t start = entries[i].start;
+		idx_t end = start;
+		idx_t size = 0;
+		while (i < entries.size() && may_match[i] && size < SCAN_RANGE_SIZE) {
+			end = entries[i].end;
+			if (unit_format == ZeekBlockFormat::NONE) {
+				size += entries[i].end - entries[i].start;
+			} else {
+				for (idx_t block_idx = entries[i].start; block_idx < entries[i].end; block_idx++) {
+					size += blocks[block_idx].decompressed_size;
+				}
+			}
+			i++;
 		}
+		gstate.units.push_back({file_idx, start, end, unit_format, size});
 	}
-
-	// Capture any pushed-down filters for per-row evaluation.
-	result->filters = input.filters;
-
-	return std::move(result);
+	return true;
 }
 
-static unique_ptr<LocalTableFunctionState> ZeekScanInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
-                                                             GlobalTableFunctionState *global_state) {
-	auto &gstate = global_state->Cast<ZeekScanGlobalState>();
-	auto result = make_uniq<ZeekScanLocalState>();
-
-	// Allocate this thread's read buffer.
-	result->read_buffer.resize(READ_BUFFER_SIZE);
+//! Returns false if the file's rotation interval (see ZeekReader::ParseRotationInterval) shows that
+//! none of its records can satisfy `ts_filter`. The interval only bounds ts as far as the user vouches
+//! for it: records may start well before the interval (e.g. long-lived connections), and a file that
+//! was renamed, or written by a sensor with a skewed clock, can hold records from after it. Each side
+//! therefore only bounds ts given its slack, ts_lag for the start and ts_lead for the end.
+static bool RotationIntervalMayMatch(const ZeekScanBindData &bind_data, const string &path,
+                                     const TableFilter &ts_filter) {
+	if (!bind_data.has_ts_lag && !bind_data.has_ts_lead) {
+		return true;
+	}
+	timestamp_tz_t start, end;
+	if (!ZeekReader::ParseRotationInterval(path, start, end)) {
+		return true;
+	}
+	int64_t min_ts = Timestamp::ninfty().value;
+	if (bind_data.has_ts_lag) {
+		min_ts = start.value - Interval::GetMicro(bind_data.ts_lag);
+	}
+	int64_t max_ts = Timestamp::infinity().value;
+	if (bind_data.has_ts_lead) {
+		max_ts = end.value + Interval::GetMicro(bind_data.ts_lead);
+	}
+	auto stats = BaseStatistics::CreateUnknown(LogicalType::TIMESTAMP_TZ);
+	NumericStats::SetMin(stats, Value::TIMESTAMPTZ(timestamp_tz_t(min_ts)));
+	NumericStats::SetMax(stats, Value::TIMESTAMPTZ(timestamp_tz_t(max_ts)));
+	return ts_filter.CheckStatistics(stats) != FilterPropagateResult::FILTER_ALWAYS_FALSE;
+}
 
-	// Allocate per-thread cast temp vectors based on global state's needs_cast_buffer.
-	result->cast_temp_vecs.resize(gstate.needs_cast_buffer.size());
-	for (idx_t out_idx = 0; out_idx < gstate.needs_cast_buffer.size(); out_idx++) {
-		if (gstate.needs_cast_buffer[out_idx]) {
-			result->cast_temp_vecs[out_idx] = make_uniq<Vector>(LogicalType::VARCHAR, STANDARD_VECTOR_SIZE);
+//! Keep a `sample` fraction of the scan units, each unit being kept if the hash of its path and
+//! offset falls below the fraction, so that repeated scans read the same sample. Split units start
+//! at line boundaries like any other, so a sampled range or block run needs no special handling. A
+//! non-empty scan keeps at least one unit.
+static void SampleUnits(const ZeekScanBindData &bind_data, ZeekScanGlobalState &gstate) {
+	vector<ZeekScanUnit> kept;
+	idx_t min_hash_idx = 0;
+	hash_t min_hash = NumericLimits<hash_t>::Maximum();
+	for (idx_t i = 0; i < gstate.units.size(); i++) {
+		auto &unit = gstate.units[i];
+		auto &path = bind_data.file_paths[unit.file_idx];
+		const hash_t hash = CombineHash(Hash(path.c_str(), path.size()), Hash<idx_t>(unit.start));
+		// The top 53 bits, as a double in [0, 1).
+		if (double(hash >> 11) / double(idx_t(1) << 53) < bind_data.sample) {
+			kept.push_back(unit);
+		}
+		if (hash < min_hash) {
+			min_hash = hash;
+			min_hash_idx = i;
 		}
 	}
+	if (kept.empty() && !gstate.units.empty()) {
+		kept.push_back(gstate.units[min_hash_idx]);
+	}
+	if (!kept.empty()) {
+		gstate.sample_weight = double(gstate.units.size()) / double(kept.size());
+	}
+	gstate.units = std::move(kept);
+}
 
-	return std::move(result);
+//! The writer of a scan that writes Parquet: each file gets its own columns, in its own field order.
+static unique_ptr<ZeekParquetWriter> MakeParquetWriter(ClientContext &context, const ZeekScanBindData &bind_data,
+                                                       const ZeekScanGlobalState &gstate) {
+	vector<ZeekParquetFileSpec> specs(bind_data.file_paths.size());
+	for (auto &unit : gstate.units) {
+		specs[unit.file_idx].unit_count++;
+	}
+	const idx_t data_col_count = bind_data.column_types.size();
+	for (idx_t file_idx = 0; file_idx < specs.size(); file_idx++) {
+		auto &spec = specs[file_idx];
+		if (bind_data.union_by_name) {
+			auto &field_lookup = bind_data.union_to_file_field[file_idx];
+			for (idx_t field_idx = 0; field_idx < data_col_count; field_idx++) {
+				auto schema_col = std::find(field_lookup.begin(), field_lookup.end(), field_idx);
+				if (schema_col == field_lookup.end()) {
+					break;
+				}
+				spec.column_ids.push_back(NumericCast<idx_t>(schema_col - field_lookup.begin()));
+			}
+		} else {
+			for (idx_t schema_col = 0; schema_col < data_col_count; schema_col++) {
+				spec.column_ids.push_back(schema_col);
+			}
+		}
+		// A file whose header bind couldn't read (see ignore_file_errors) isn't written.
+		if (spec.column_ids.empty()) {
+			continue;
+		}
+		spec.path = bind_data.parquet_paths[file_idx];
+		spec.source_value = bind_data.file_paths[file_idx];
+		for (auto schema_col : spec.column_ids) {
+			if (bind_data.header.fields[schema_col] == "ts" &&
+			    bind_data.column_types[schema_col].id() == LogicalTypeId::TIMESTAMP_TZ) {
+				spec.ts_column = spec.names.size();
+			}
+			spec.names.push_back(bind_data.column_names[schema_col]);
+			spec.types.push_back(bind_data.varchar_inet_types[schema_col]);
+		}
+	}
+	return make_uniq<ZeekParquetWriter>(context, std::move(specs), bind_data.parquet_compression,
+	                                    bind_data.parquet_source_column);
 }
 
-static void ZeekScanExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
-	auto &bind_data = data.bind_data->Cast<ZeekScanBindData>();
-	auto &gstate = data.global_state->Cast<ZeekScanGlobalState>();
-	auto &lstate = data.local_state->Cast<ZeekScanLocalState>();
+unique_ptr<ZeekScanGlobalState> ZeekScan::InitGlobal(ClientContext &context, const ZeekScanBindData &bind_data,
+                                                     const vector<column_t> &column_ids,
+                                                     optional_ptr<TableFilterSet> filters) {
+	auto result = make_uniq<ZeekScanGlobalState>();
+	result->stats = ZeekScanStatsRegistry::Get(context).BeginScan(bind_data.pattern);
 
-	if (lstate.finished) {
-		output.SetCardinality(0);
-		return;
+	// Resolve projection: which schema columns does the query actually want?
+	// column_ids is provided by DuckDB when projection_pushdown = true.
+	// No columns (or only the row-id placeholder DuckDB uses for COUNT(*)) means only the row
+	// count is needed.
+	bool only_virtual_columns = true;
+	for (auto &col_id : column_ids) {
+		if (!IsVirtualColumn(col_id)) {
+			only_virtual_columns = false;
+		}
+	}
+	if (!only_virtual_columns) {
+		for (auto &col_id : column_ids) {
+			result->projected_schema_cols.push_back(col_id);
+		}
 	}
+	// In tail mode every line is looked at, to leave out those before the resume offset and the one
+	// still being written. A scan that writes Parquet converts every line.
+	result->count_only = only_virtual_columns && !bind_data.tail && !bind_data.WritesParquet();
 
-	idx_t row_count = 0;
+	// Resolve how each projected column is filled. Threads allocate a temp VARCHAR vector for each
+	// column on the batched cast path. A scan that writes Parquet converts all data columns.
 	const idx_t data_col_count = bind_data.column_types.size();
-	const idx_t filename_col_idx = data_col_count; // virtual column index for filename
-	const string &unset_field = bind_data.header.unset_field;
-	const string &empty_field = bind_data.header.empty_field;
-	const char field_separator = bind_data.header.separator;
+	if (bind_data.WritesParquet()) {
+		for (column_t schema_col = 0; schema_col < data_col_count; schema_col++) {
+			result->converters.push_back(MakeColumnConverter(bind_data, schema_col));
+		}
+	} else {
+		for (auto schema_col : result->projected_schema_cols) {
+			result->converters.push_back(MakeColumnConverter(bind_data, schema_col));
+		}
+	}
 
-	while (row_count < STANDARD_VECTOR_SIZE) {
-		// Open the first/next file if this thread doesn't currently have one.
-		if (!lstate.file_handle) {
-			if (!OpenNextFile(context, gstate, lstate, bind_data)) {
-				lstate.finished = true;
-				break;
+	// Compile any pushed-down filters for per-row evaluation. A scan that writes Parquet gets no
+	// filters but optional ones (see ZeekSupportsPushdownType), which it leaves to the operators
+	// above, so that the files get every row.
+	if (filters && !bind_data.WritesParquet()) {
+		result->filters = filters;
+		for (auto &entry : filters->filters) {
+			column_t schema_col = result->projected_schema_cols[entry.first];
+			const auto &type =
+			    schema_col < data_col_count ? bind_data.column_types[schema_col] : LogicalType::VARCHAR;
+			result->column_filters.push_back({schema_col, ZeekColumnFilter::Compile(*entry.second, type)});
+			vector<shared_ptr<DynamicFilterData>> dynamic_filters;
+			ZeekDynamicFilter::Collect(*entry.second, dynamic_filters);
+			for (auto &filter_data : dynamic_filters) {
+				result->dynamic_filters.push_back({schema_col, type, filter_data});
 			}
 		}
+	}
 
-		if (!ReadLineBuffered(lstate)) {
-			// EOF on current file — release it and try the next.
-			lstate.file_handle.reset();
+	// Split the files into scan units, leaving out files, or with an index the parts of files, that a
+	// `ts` filter rules out. COUNT(*) takes the row counts of indexed files from their index.
+	optional_ptr<const TableFilter> ts_filter = FindTimestampFilter(bind_data, *result);
+	bool ts_null_passes = true;
+	for (auto &entry : result->column_filters) {
+		if (ts_filter && entry.schema_col < data_col_count && bind_data.header.fields[entry.schema_col] == "ts") {
+			ts_null_passes = entry.filter->EvaluateNull();
+		}
+	}
+	auto &fs = FileSystem::GetFileSystem(context);
+	result->file_blocks.resize(bind_data.file_paths.size());
+	for (idx_t file_idx = 0; file_idx < bind_data.file_paths.size(); file_idx++) {
+		if (ts_filter && !RotationIntervalMayMatch(bind_data, bind_data.file_paths[file_idx], *ts_filter)) {
 			continue;
 		}
-
-		// Skip empty lines and Zeek metadata comment lines.
-		if (lstate.line_buffer.empty() || lstate.line_buffer[0] == '#') {
+		auto &index = bind_data.file_indexes[file_idx];
+		if (index && result->count_only && bind_data.sample == 1) {
+			result->indexed_row_count += index->RowCount();
 			continue;
 		}
-
-		// COUNT(*) fast path: no columns needed, just count rows.
-		if (gstate.count_only) {
-			row_count++;
+		if (index && ts_filter &&
+		    AddIndexedScanUnits(fs, bind_data, file_idx, *index, *ts_filter, ts_null_passes, *result)) {
 			continue;
 		}
+		AddScanUnits(fs, bind_data, file_idx, *result);
+	}
+	if (bind_data.sample < 1) {
+		SampleUnits(bind_data, *result);
+	}
 
-		// Tokenize the line into field slices (reused vector — no allocation per row in steady state).
-		TokenizeSpan(lstate.line_buffer.data(), static_cast<uint32_t>(lstate.line_buffer.size()), field_separator,
-		             lstate.field_slices);
-		const idx_t num_fields = lstate.field_slices.size();
-
-		// Evaluate pushed-down filters on this row. If any filter fails, skip the entire row
-		// without parsing the non-filter projected columns.
-		if (gstate.filters) {
-			bool row_passes = true;
-			for (auto &entry : gstate.filters->filters) {
-				idx_t filter_out_idx = entry.first; // index into projected_schema_cols
-				const TableFilter &filter = *entry.second;
-				column_t schema_col = gstate.projected_schema_cols[filter_out_idx];
-
-				// Filename virtual column filter (VARCHAR).
-				if (bind_data.filename_column && schema_col == filename_col_idx) {
-					Value v(lstate.current_file_path);
-					if (!EvaluateFilter(filter, v, false)) {
-						row_passes = false;
-						break;
-					}
-					continue;
-				}
+	// Chunks of indexed rows come before those of the units in batch order.
+	const idx_t indexed_rows = result->indexed_row_count.load();
+	result->indexed_batch_count = (indexed_rows + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
 
-				// Translate from bound schema column to this file's field position. In union
-				// mode the field may be absent (idx_t(-1) wraps to a value larger than num_fields).
-				idx_t file_field_idx = lstate.field_lookup[schema_col];
-				if (file_field_idx >= num_fields) {
-					Value null_val(bind_data.column_types[schema_col]);
-					if (!EvaluateFilter(filter, null_val, true)) {
-						row_passes = false;
-						break;
-					}
-					continue;
-				}
+	// Progress is measured in scanned bytes; units of unknown size count as an average one.
+	idx_t sized_units = 0;
+	for (auto &unit : result->units) {
+		if (unit.size > 0) {
+			result->total_scan_size += unit.size;
+			sized_units++;
+		}
+	}
+	if (sized_units > 0) {
+		result->total_scan_size += result->total_scan_size / sized_units * (result->units.size() - sized_units);
+	}
 
-				const FieldSlice &field = lstate.field_slices[file_field_idx];
+	if (bind_data.WritesParquet()) {
+		result->parquet_writer = MakeParquetWriter(context, bind_data, *result);
+	}
+	return result;
+}
 
-				// Unset/empty marker → treat as NULL.
-				if (SliceEquals(field, unset_field) || SliceEquals(field, empty_field)) {
-					Value null_val(bind_data.column_types[schema_col]);
-					if (!EvaluateFilter(filter, null_val, true)) {
-						row_passes = false;
-						break;
-					}
-					continue;
-				}
+static unique_ptr<GlobalTableFunctionState> ZeekScanInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+	return ZeekScan::InitGlobal(context, input.bind_data->Cast<ZeekScanBindData>(), input.column_ids, input.filters);
+}
 
-				// Parse the slice into a Value of the column's type and evaluate.
-				Value row_val = SliceToValue(field, bind_data.column_types[schema_col]);
-				if (!EvaluateFilter(filter, row_val, row_val.IsNull())) {
-					row_passes = false;
-					break;
-				}
+unique_ptr<ZeekScanLocalState> ZeekScan::InitLocal(ExecutionContext &context, const ZeekScanBindData &bind_data,
+                                                   ZeekScanGlobalState &gstate) {
+	auto result = make_uniq<ZeekScanLocalState>();
+
+	// The first thread decides the unit order, before any thread claims a unit. Sinks that need
+	// batch order (insertion-order preserving collectors, inserts and COPYs) get the units in file
+	// order, which their batch indexes follow. Anything else gets the largest units first, so that
+	// a file much larger than its neighbours isn't left to run on one thread after the others have
+	// finished. Ties (e.g. the ranges of a split file) keep file order, and units of unknown size go
+	// last.
+	{
+		lock_guard<mutex> guard(gstate.order_lock);
+		if (!gstate.order_decided) {
+			optional_ptr<PhysicalOperator> sink;
+			if (context.pipeline) {
+				sink = context.pipeline->GetSink();
 			}
-			if (!row_passes) {
-				continue;
+			gstate.preserve_order = sink && sink->RequiredPartitionInfo().batch_index;
+			if (!gstate.preserve_order) {
+				std::stable_sort(gstate.units.begin(), gstate.units.end(),
+				                 [](const ZeekScanUnit &a, const ZeekScanUnit &b) { return a.size > b.size; });
 			}
+			gstate.order_decided = true;
 		}
+	}
 
-		// Walk projected output columns and emit values for those.
-		for (idx_t out_idx = 0; out_idx < gstate.projected_schema_cols.size(); out_idx++) {
-			column_t schema_col = gstate.projected_schema_cols[out_idx];
-			auto &vec = output.data[out_idx];
+	// Allocate this thread's read buffer.
+	result->read_size = bind_data.buffer_size > 0 ? bind_data.buffer_size : READ_BUFFER_SIZE;
+	result->read_buffer = make_buffer<ZeekReadBuffer>(result->read_size);
+	result->attached_read_buffers.resize(gstate.converters.size(), nullptr);
+
+	// Allocate per-thread cast temp vectors for the columns on the batched cast path.
+	result->cast_temp_vecs.resize(gstate.converters.size());
+	result->list_reserve.resize(gstate.converters.size(), 0);
+	for (idx_t out_idx = 0; out_idx < gstate.converters.size(); out_idx++) {
+		if (gstate.converters[out_idx].cast_buffer) {
+			result->cast_temp_vecs[out_idx] = make_uniq<Vector>(gstate.converters[out_idx].cast_type);
+		}
+	}
 
-			// Filename virtual column.
-			if (bind_data.filename_column && schema_col == filename_col_idx) {
-				FlatVector::GetData<string_t>(vec)[row_count] = StringVector::AddString(vec, lstate.current_file_path);
-				continue;
-			}
+	// Dictionaries for the dictionary-encoded columns this scan projects or filters. A scan that
+	// writes Parquet converts into flat vectors, which are written as they are.
+	result->dictionaries.resize(bind_data.column_types.size());
+	auto add_dictionary = [&](column_t schema_col) {
+		if (schema_col < bind_data.column_types.size() && bind_data.dictionary_columns[schema_col] &&
+		    !result->dictionaries[schema_col] && !gstate.parquet_writer) {
+			result->dictionaries[schema_col] = make_uniq<ZeekColumnDictionary>();
+		}
+	};
+	for (auto schema_col : gstate.projected_schema_cols) {
+		add_dictionary(schema_col);
+	}
+	for (auto &entry : gstate.column_filters) {
+		add_dictionary(entry.schema_col);
+	}
+	for (auto &entry : gstate.dynamic_filters) {
+		result->dynamic_filters.push_back(make_uniq<ZeekDynamicFilter>(entry.data, entry.type));
+	}
 
-			// For non-native columns (e.g. INET) we accumulate into a temp VARCHAR vector and
-			// batch-cast to the real output at end of chunk. For native columns target_vec == vec.
-			Vector &target_vec = lstate.cast_temp_vecs[out_idx] ? *lstate.cast_temp_vecs[out_idx] : vec;
+	if (gstate.parquet_writer) {
+		result->parquet_chunk.Initialize(Allocator::Get(context.client), bind_data.varchar_inet_types);
+		result->execution_context = make_uniq<ExecutionContext>(context.client, context.thread, context.pipeline);
+	}
+	return result;
+}
 
-			// Translate from bound schema column to this file's field position. In union mode
-			// the field may be absent (idx_t(-1) wraps to a value larger than num_fields).
-			idx_t file_field_idx = lstate.field_lookup[schema_col];
-			if (file_field_idx >= num_fields) {
-				FlatVector::SetNull(target_vec, row_count, true);
-				continue;
+static unique_ptr<LocalTableFunctionState> ZeekScanInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                                                             GlobalTableFunctionState *global_state) {
+	return ZeekScan::InitLocal(context, input.bind_data->Cast<ZeekScanBindData>(),
+	                           global_state->Cast<ZeekScanGlobalState>());
+}
+
+//! Convert the rows of the line batch that passed the filters into `output`, from row `row_offset`
+//! on, one column at a time.
+static void ConvertLineBatch(ZeekConvertInput &convert_input, const ZeekScanGlobalState &gstate, DataChunk &output,
+                             idx_t row_offset) {
+	auto &bind_data = convert_input.bind_data;
+	auto &lstate = convert_input.lstate;
+	auto &batch = lstate.batch;
+	const idx_t count = batch.selected;
+	for (idx_t out_idx = 0; out_idx < gstate.converters.size(); out_idx++) {
+		const ZeekColumnConverter &conv = gstate.converters[out_idx];
+		auto &vec = output.data[out_idx];
+
+		switch (conv.source) {
+		case ZeekColumnConverter::Source::FIELD:
+			break;
+		case ZeekColumnConverter::Source::FILENAME:
+		case ZeekColumnConverter::Source::LOG_ID: {
+			// The same for every row of the batch, which never spans two files.
+			const auto &value =
+			    conv.source == ZeekColumnConverter::Source::FILENAME ? lstate.current_file_path : lstate.current_log_id;
+			auto data = FlatVector::GetData<string_t>(vec);
+			if (count > 0) {
+				const string_t str = StringVector::AddString(vec, value);
+				std::fill(data + row_offset, data + row_offset + count, str);
+			}
+			continue;
+		}
+		case ZeekColumnConverter::Source::NEXT_OFFSET: {
+			auto data = FlatVector::GetData<uint64_t>(vec);
+			for (idx_t i = 0; i < count; i++) {
+				data[row_offset + i] = batch.rows[batch.sel.get_index(i)].next_offset;
 			}
+			continue;
+		}
+		case ZeekColumnConverter::Source::SAMPLE_WEIGHT: {
+			auto data = FlatVector::GetData<double>(vec);
+			std::fill(data + row_offset, data + row_offset + count, gstate.sample_weight);
+			continue;
+		}
+		}
 
-			const FieldSlice &field = lstate.field_slices[file_field_idx];
+		// Dictionary-encoded column: record the rows' entries; the vector is built at end of chunk.
+		auto &dict = lstate.dictionaries[conv.schema_col];
+		if (dict) {
+			const bool looked_up = dict->batch_number == batch.number;
+			for (idx_t i = 0; i < count; i++) {
+				const idx_t r = batch.sel.get_index(i);
+				dict->sel.set_index(row_offset + i, looked_up ? dict->batch_entries[r]
+				                                              : LookupDictionaryEntry(bind_data, lstate, *dict,
+				                                                                      conv.schema_col, r));
+			}
+			continue;
+		}
 
-			if (SliceEquals(field, unset_field) || SliceEquals(field, empty_field)) {
-				FlatVector::SetNull(target_vec, row_count, true);
+		// For non-native columns (e.g. INET) we accumulate into a temp VARCHAR vector and batch-cast to
+		// the real output at end of chunk. For native columns target_vec == vec.
+		Vector &target_vec = conv.cast_buffer ? *lstate.cast_temp_vecs[out_idx] : vec;
+
+		// Translate from bound schema column to this file's field position. In union mode the field
+		// may be absent (idx_t(-1) wraps to a value larger than the row's field count).
+		const idx_t file_field_idx = lstate.field_lookup[conv.schema_col];
+		convert_input.out_idx = out_idx;
+		convert_input.column = &conv;
+		for (idx_t i = 0; i < count; i++) {
+			const idx_t r = batch.sel.get_index(i);
+			const auto &row = batch.rows[r];
+			if (file_field_idx >= row.field_count) {
+				FlatVector::SetNull(target_vec, row_offset + i, true);
 				continue;
 			}
+			convert_input.buffer_idx = row.buffer_idx;
+			conv.convert(convert_input, target_vec, row_offset + i, batch.slices[r * batch.stride + file_field_idx]);
+		}
+	}
+}
 
-			string_t field_str(field.ptr, field.len);
-			auto type_id = bind_data.column_types[schema_col].id();
+//! Write the rows of the chunk, which the scan converted into parquet_chunk, to the current unit's
+//! file, and fill the projected columns of `output` from them. Ends the unit if it has no more rows.
+static void WriteParquetChunk(ClientContext &context, const ZeekScanBindData &bind_data,
+                              ZeekScanGlobalState &gstate, ZeekScanLocalState &lstate, DataChunk &output,
+                              idx_t row_count) {
+	auto &chunk = lstate.parquet_chunk;
+	chunk.SetCardinality(row_count);
+	gstate.parquet_writer->Write(*lstate.execution_context, lstate.parquet_unit, chunk);
+	const idx_t data_col_count = bind_data.column_types.size();
+	for (idx_t out_idx = 0; out_idx < gstate.projected_schema_cols.size(); out_idx++) {
+		const column_t schema_col = gstate.projected_schema_cols[out_idx];
+		auto &vec = output.data[out_idx];
+		if (schema_col >= data_col_count) {
+			// The filename column; the chunk doesn't span two units.
+			vec.Reference(Value(lstate.current_file_path));
+		} else if (bind_data.column_types[schema_col] == bind_data.varchar_inet_types[schema_col]) {
+			vec.Reference(chunk.data[schema_col]);
+		} else {
+			const uint64_t cast_start = ZeekScanCounters::Now();
+			VectorOperations::Cast(context, chunk.data[schema_col], vec, row_count);
+			lstate.counters.cast_ns += ZeekScanCounters::Now() - cast_start;
+		}
+	}
+	if (!lstate.file_handle) {
+		gstate.parquet_writer->EndUnit(*lstate.execution_context, lstate.parquet_unit);
+	}
+}
 
-			switch (type_id) {
-			case LogicalTypeId::VARCHAR: {
-				FlatVector::GetData<string_t>(vec)[row_count] = StringVector::AddString(vec, field.ptr, field.len);
-				break;
-			}
-			case LogicalTypeId::DOUBLE: {
-				double val;
-				if (TryCast::Operation<string_t, double>(field_str, val)) {
-					FlatVector::GetData<double>(vec)[row_count] = val;
-				} else {
-					FlatVector::SetNull(vec, row_count, true);
-				}
+void ZeekScan::Scan(ClientContext &context, const ZeekScanBindData &bind_data, ZeekScanGlobalState &gstate,
+                    ZeekScanLocalState &lstate, DataChunk &output) {
+	if (lstate.finished) {
+		output.SetCardinality(0);
+		return;
+	}
+
+	idx_t row_count = gstate.count_only ? ClaimIndexedRows(gstate, STANDARD_VECTOR_SIZE) : 0;
+	if (row_count > 0 && gstate.preserve_order) {
+		lstate.batch_index = gstate.next_indexed_batch++;
+		output.SetCardinality(row_count);
+		return;
+	}
+	std::fill(lstate.attached_read_buffers.begin(), lstate.attached_read_buffers.end(), nullptr);
+	// The converters fill `output`, or when the scan writes Parquet the thread's parquet_chunk.
+	auto &parquet_writer = gstate.parquet_writer;
+	if (parquet_writer) {
+		lstate.parquet_chunk.Reset();
+	}
+	DataChunk &converted = parquet_writer ? lstate.parquet_chunk : output;
+	// Temp vectors start each chunk empty (without the previous chunk's NULLs, strings and list
+	// elements), and list columns start with the room their elements took in the previous chunk.
+	for (idx_t out_idx = 0; out_idx < gstate.converters.size(); out_idx++) {
+		auto &temp_vec = lstate.cast_temp_vecs[out_idx];
+		if (temp_vec) {
+			temp_vec->Initialize(false, STANDARD_VECTOR_SIZE);
+		}
+		if (lstate.list_reserve[out_idx] > 0) {
+			ListVector::Reserve(temp_vec ? *temp_vec : converted.data[out_idx], lstate.list_reserve[out_idx]);
+		}
+	}
+	// Pick up the dynamic filters' current constants.
+	lstate.active_dynamic_filters.clear();
+	for (idx_t i = 0; i < lstate.dynamic_filters.size(); i++) {
+		auto filter = lstate.dynamic_filters[i]->Refresh();
+		if (filter) {
+			lstate.active_dynamic_filters.push_back({gstate.dynamic_filters[i].schema_col, filter});
+		}
+	}
+	const char field_separator = bind_data.header.separator;
+	ZeekConvertInput convert_input(context, bind_data, lstate);
+
+	while (row_count < STANDARD_VECTOR_SIZE) {
+		// Open the first/next file if this thread doesn't currently have one. A chunk that keeps order,
+		// or is written to Parquet, ends with its unit.
+		if (!lstate.file_handle) {
+			if ((gstate.preserve_order || parquet_writer) && row_count > 0) {
 				break;
 			}
-			case LogicalTypeId::UBIGINT: {
-				uint64_t val;
-				if (TryCast::Operation<string_t, uint64_t>(field_str, val)) {
-					FlatVector::GetData<uint64_t>(vec)[row_count] = val;
-				} else {
-					FlatVector::SetNull(vec, row_count, true);
-				}
-				break;
+			if (parquet_writer) {
+				parquet_writer->EndUnit(*lstate.execution_context, lstate.parquet_unit);
 			}
-			case LogicalTypeId::BIGINT: {
-				int64_t val;
-				if (TryCast::Operation<string_t, int64_t>(field_str, val)) {
-					FlatVector::GetData<int64_t>(vec)[row_count] = val;
-				} else {
-					FlatVector::SetNull(vec, row_count, true);
-				}
+			if (!OpenNextFile(context, gstate, lstate, bind_data)) {
+				lstate.finished = true;
 				break;
 			}
-			case LogicalTypeId::BOOLEAN: {
-				FlatVector::GetData<bool>(vec)[row_count] = (field.len == 1 && field.ptr[0] == 'T') ||
-				                                            (field.len == 4 && std::memcmp(field.ptr, "true", 4) == 0);
-				break;
+			if (parquet_writer && lstate.file_changed && !bind_data.parquet_source_column.empty()) {
+				// A cache entry is keyed on the log as bind saw it, so a log that changed since isn't cached.
+				parquet_writer->AbandonUnit(lstate.current_file_idx);
+			} else if (parquet_writer) {
+				parquet_writer->BeginUnit(*lstate.execution_context, lstate.current_file_idx, lstate.parquet_unit);
 			}
-			case LogicalTypeId::TIMESTAMP_TZ: {
-				double val;
-				if (TryCast::Operation<string_t, double>(field_str, val)) {
-					FlatVector::GetData<timestamp_tz_t>(vec)[row_count] = EpochSecondsToTimestampTZ(val);
-				} else {
-					FlatVector::SetNull(vec, row_count, true);
-				}
-				break;
+		}
+
+		// COUNT(*) fast path: no columns needed, just count rows.
+		if (gstate.count_only) {
+			const idx_t counted_before = row_count;
+			if (!CountRowsBuffered(lstate, STANDARD_VECTOR_SIZE - row_count, row_count)) {
+				CloseCurrentFile(lstate);
 			}
-			case LogicalTypeId::INTERVAL: {
-				double val;
-				if (TryCast::Operation<string_t, double>(field_str, val)) {
-					FlatVector::GetData<interval_t>(vec)[row_count] = SecondsToInterval(val);
-				} else {
-					FlatVector::SetNull(vec, row_count, true);
-				}
-				break;
+			lstate.counters.lines_read += row_count - counted_before;
+			continue;
+		}
+
+		// Read as many lines as the chunk has room for, filter them, and convert those that pass. Block
+		// reads are timed on their own, so their time is taken out of the tokenizing phase.
+		uint64_t phase_start = ZeekScanCounters::Now();
+		const uint64_t read_ns_before = lstate.counters.read_ns;
+		const bool unit_has_lines = ReadLineBatch(bind_data, lstate, STANDARD_VECTOR_SIZE - row_count);
+		uint64_t now = ZeekScanCounters::Now();
+		const uint64_t read_ns = lstate.counters.read_ns - read_ns_before;
+		if (now - phase_start > read_ns) {
+			lstate.counters.tokenize_ns += now - phase_start - read_ns;
+		}
+		phase_start = now;
+
+		auto &batch = lstate.batch;
+		if (gstate.column_filters.empty() && lstate.active_dynamic_filters.empty()) {
+			for (idx_t r = 0; r < batch.rows.size(); r++) {
+				batch.sel.set_index(r, r);
 			}
-			case LogicalTypeId::USMALLINT: {
-				uint16_t val;
-				if (TryCast::Operation<string_t, uint16_t>(field_str, val)) {
-					FlatVector::GetData<uint16_t>(vec)[row_count] = val;
-				} else {
-					FlatVector::SetNull(vec, row_count, true);
+			batch.selected = batch.rows.size();
+		} else {
+			FilterLineBatch(bind_data, gstate, lstate);
+			now = ZeekScanCounters::Now();
+			lstate.counters.filter_ns += now - phase_start;
+			phase_start = now;
+			lstate.counters.rows_filtered += batch.rows.size() - batch.selected;
+			if (lstate.filter_fields < lstate.max_needed_fields) {
+				for (idx_t i = 0; i < batch.selected; i++) {
+					FinishTokenizing(lstate, batch.sel.get_index(i), field_separator);
 				}
-				break;
-			}
-			case LogicalTypeId::LIST: {
-				auto &child_type = ListType::GetChildType(bind_data.column_types[schema_col]);
-				AppendListValue(context, lstate, vec, row_count, field, bind_data.header.set_separator, child_type,
-				                unset_field, empty_field);
-				break;
-			}
-			default: {
-				// Non-native type (e.g. INET): write the slice into the temp VARCHAR vector
-				// (target_vec is the temp). The batch cast at end of chunk converts to the real type.
-				FlatVector::GetData<string_t>(target_vec)[row_count] =
-				    StringVector::AddString(target_vec, field.ptr, field.len);
-				break;
-			}
+				now = ZeekScanCounters::Now();
+				lstate.counters.tokenize_ns += now - phase_start;
+				phase_start = now;
 			}
 		}
 
-		row_count++;
+		ConvertLineBatch(convert_input, gstate, converted, row_count);
+		lstate.counters.convert_ns += ZeekScanCounters::Now() - phase_start;
+		row_count += batch.selected;
+		ReleaseLineBatch(lstate);
+		if (!unit_has_lines) {
+			// EOF on current file — release it and try the next.
+			CloseCurrentFile(lstate);
+		}
 	}
 
-	// Batch-cast each non-native column's accumulated VARCHAR slices into its real output vector.
+	// Note each list column's size for the next chunk, and batch-cast each non-native column's
+	// accumulated VARCHAR slices into its real output vector.
 	if (row_count > 0) {
-		for (idx_t out_idx = 0; out_idx < lstate.cast_temp_vecs.size(); out_idx++) {
+		for (idx_t out_idx = 0; out_idx < gstate.converters.size(); out_idx++) {
+			if (gstate.converters[out_idx].convert_element) {
+				auto &temp_vec = lstate.cast_temp_vecs[out_idx];
+				lstate.list_reserve[out_idx] =
+				    ListVector::GetListSize(temp_vec ? *temp_vec : converted.data[out_idx]);
+			}
 			if (!lstate.cast_temp_vecs[out_idx]) {
 				continue;
 			}
-			VectorOperations::Cast(context, *lstate.cast_temp_vecs[out_idx], output.data[out_idx], row_count);
+			const uint64_t cast_start = ZeekScanCounters::Now();
+			VectorOperations::Cast(context, *lstate.cast_temp_vecs[out_idx], converted.data[out_idx], row_count);
+			lstate.counters.cast_ns += ZeekScanCounters::Now() - cast_start;
+		}
+		for (idx_t out_idx = 0; out_idx < gstate.projected_schema_cols.size(); out_idx++) {
+			column_t schema_col = gstate.projected_schema_cols[out_idx];
+			if (schema_col < lstate.dictionaries.size() && lstate.dictionaries[schema_col]) {
+				lstate.dictionaries[schema_col]->Emit(output.data[out_idx]);
+			}
+		}
+	}
+	if (parquet_writer) {
+		WriteParquetChunk(context, bind_data, gstate, lstate, output, row_count);
+	}
+	// Columns with too many distinct values go back to flat vectors from the next chunk on.
+	for (auto &dict : lstate.dictionaries) {
+		if (dict && dict->Overflowed()) {
+			dict.reset();
 		}
 	}
 
+	if (lstate.unreported_bytes > 0) {
+		gstate.bytes_scanned.fetch_add(lstate.unreported_bytes, std::memory_order_relaxed);
+		lstate.unreported_bytes = 0;
+	}
+	lstate.counters.rows_emitted += row_count;
+	gstate.stats->Add(lstate.counters);
+	lstate.counters = ZeekScanCounters();
 	output.SetCardinality(row_count);
 }
 
+static void ZeekScanExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	ZeekScan::Scan(context, data.bind_data->Cast<ZeekScanBindData>(), data.global_state->Cast<ZeekScanGlobalState>(),
+	               data.local_state->Cast<ZeekScanLocalState>(), output);
+}
+
+//! Average line length of the files, from the lines sampled after the headers bind parsed.
+static double EstimateLineLength(const ZeekScanBindData &bind_data) {
+	double total = 0;
+	idx_t count = 0;
+	for (auto &header : bind_data.file_headers) {
+		if (header && header->sample_line_length > 0) {
+			total += header->sample_line_length;
+			count++;
+		}
+	}
+	return count > 0 ? total / double(count) : double(DEFAULT_LINE_LENGTH_ESTIMATE);
+}
+
+//! Callback: estimated row count. Indexed files contribute their exact row count, the others their
+//! size, as estimated at bind, divided by the sampled line length.
+static unique_ptr<NodeStatistics> ZeekScanCardinality(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &bind_data = bind_data_p->Cast<ZeekScanBindData>();
+	if (!bind_data.scan_bytes_known) {
+		return make_uniq<NodeStatistics>();
+	}
+	const auto scan_rows = static_cast<idx_t>(double(bind_data.estimated_scan_bytes) / EstimateLineLength(bind_data));
+	const double rows = double(bind_data.indexed_rows + scan_rows) * bind_data.sample;
+	return make_uniq<NodeStatistics>(static_cast<idx_t>(rows));
+}
+
+//! Callback: percentage of the scan's bytes that the scanner threads have read so far.
+static double ZeekScanProgress(ClientContext &context, const FunctionData *bind_data_p,
+                               const GlobalTableFunctionState *global_state) {
+	auto &gstate = global_state->Cast<ZeekScanGlobalState>();
+	if (gstate.units.empty()) {
+		return 100.0;
+	}
+	if (gstate.total_scan_size == 0) {
+		// Only units of unknown size: count the units handed out.
+		const idx_t claimed = MinValue<idx_t>(gstate.next_unit_idx.load(), gstate.units.size());
+		return 100.0 * double(claimed) / double(gstate.units.size());
+	}
+	const double scanned = double(gstate.bytes_scanned.load(std::memory_order_relaxed));
+	return MinValue<double>(100.0, 100.0 * scanned / double(gstate.total_scan_size));
+}
+
+//! Callback: statistics of the `ts` column, when every file bounds it. An index gives a file's exact
+//! range. A rotation interval only bounds ts as far as the user vouches for it with ts_lead (see
+//! RotationIntervalMayMatch), and then only from above, so the minimum is only known if every file is
+//! indexed. ts_lag is not used for a minimum: with both bounds DuckDB may compress ts values into the
+//! range, so a bound that rows break would corrupt them rather than just drop them.
+static unique_ptr<BaseStatistics> ZeekScanStatistics(ClientContext &context, const FunctionData *bind_data_p,
+                                                     column_t column_index) {
+	auto &bind_data = bind_data_p->Cast<ZeekScanBindData>();
+	if (column_index >= bind_data.column_types.size() || bind_data.header.fields[column_index] != "ts" ||
+	    bind_data.column_types[column_index].id() != LogicalTypeId::TIMESTAMP_TZ) {
+		return nullptr;
+	}
+	int64_t min_ts = NumericLimits<int64_t>::Maximum();
+	int64_t max_ts = NumericLimits<int64_t>::Minimum();
+	bool has_value = false;
+	bool has_min = true;
+	bool has_null = false;
+	for (idx_t file_idx = 0; file_idx < bind_data.file_paths.size(); file_idx++) {
+		auto &index = bind_data.file_indexes[file_idx];
+		if (index) {
+			for (auto &entry : index->entries) {
+				if (entry.ts_count > 0) {
+					min_ts = MinValue(min_ts, entry.min_ts);
+					max_ts = MaxValue(max_ts, entry.max_ts);
+					has_value = true;
+				}
+				has_null = has_null || entry.ts_count < entry.row_count;
+			}
+			continue;
+		}
+		timestamp_tz_t start, end;
+		if (!bind_data.has_ts_lead ||
+		    !ZeekReader::ParseRotationInterval(bind_data.file_paths[file_idx], start, end)) {
+			return nullptr;
+		}
+		has_min = false;
+		max_ts = MaxValue(max_ts, end.value + Interval::GetMicro(bind_data.ts_lead));
+		has_value = true;
+		has_null = true;
+	}
+	if (!has_value) {
+		// Only indexed files without a ts value.
+		return nullptr;
+	}
+	auto stats = BaseStatistics::CreateUnknown(LogicalType::TIMESTAMP_TZ);
+	if (!has_null) {
+		stats.Set(StatsInfo::CANNOT_HAVE_NULL_VALUES);
+	}
+	if (has_min) {
+		NumericStats::SetMin(stats, Value::TIMESTAMPTZ(timestamp_tz_t(min_ts)));
+	}
+	NumericStats::SetMax(stats, Value::TIMESTAMPTZ(timestamp_tz_t(max_ts)));
+	return stats.ToUnique();
+}
+
 //! Callback: can we push down a filter on the given (schema) column index?
 //! We return true only for types we can cheaply parse from a slice per-row.
 static bool ZeekSupportsPushdownType(const FunctionData &bind_data_p, idx_t col_idx) {
 	auto &bind_data = bind_data_p.Cast<ZeekScanBindData>();
-	// The filename virtual column is always VARCHAR; filters on it are cheap.
+	// A scan that writes Parquet has to read every row.
+	if (bind_data.WritesParquet()) {
+		return false;
+	}
+	// The filename virtual column is always VARCHAR; filters on it are cheap. The tail-mode columns are
+	// only known once a row is emitted, and sample_weight isn't worth filtering in the scan.
 	if (col_idx >= bind_data.column_types.size()) {
-		return true;
+		return bind_data.filename_column && col_idx == bind_data.column_types.size();
+	}
+	return CanPushdownFilterOnType(bind_data.column_types[col_idx], bind_data.native_inet);
+}
+
+//! Callback: the scan's counters (see ZeekScanCounters), shown by EXPLAIN ANALYZE.
+static InsertionOrderPreservingMap<string> ZeekScanDynamicToString(TableFunctionDynamicToStringInput &input) {
+	InsertionOrderPreservingMap<string> result;
+	if (!input.global_state) {
+		return result;
+	}
+	auto &gstate = input.global_state->Cast<ZeekScanGlobalState>();
+	const auto totals = gstate.stats->Totals();
+	result["Scan Units"] = to_string(totals.scan_units);
+	if (totals.files_skipped > 0) {
+		result["Files Skipped"] = to_string(totals.files_skipped);
 	}
-	return CanPushdownFilterOnType(bind_data.column_types[col_idx]);
+	result["Bytes Read"] = StringUtil::Format("%llu (%llu decompressed)", (unsigned long long)totals.compressed_bytes,
+	                                          (unsigned long long)totals.decompressed_bytes);
+	result["Lines Read"] = to_string(totals.lines_read);
+	result["Rows Filtered"] = to_string(totals.rows_filtered);
+	result["Phase Time"] = StringUtil::Format(
+	    "read %.3fs, tokenize %.3fs, filter %.3fs, convert %.3fs, cast %.3fs", double(totals.read_ns) / 1e9,
+	    double(totals.tokenize_ns) / 1e9, double(totals.filter_ns) / 1e9, double(totals.convert_ns) / 1e9,
+	    double(totals.cast_ns) / 1e9);
+	return result;
 }
 
-TableFunction GetZeekScanFunction() {
-	TableFunction func("read_zeek", {LogicalType::VARCHAR}, ZeekScanExecute, ZeekScanBind, ZeekScanInitGlobal,
+//! The batch index of the chunk just emitted: its unit's position in file order, when the sink
+//! needs batch order (see ZeekScanGlobalState::preserve_order).
+static OperatorPartitionData ZeekScanGetPartitionData(ClientContext &context, TableFunctionGetPartitionInput &input) {
+	if (input.partition_info.RequiresPartitionColumns()) {
+		throw InternalException("read_zeek: partition columns are not supported");
+	}
+	auto &lstate = input.local_state->Cast<ZeekScanLocalState>();
+	return OperatorPartitionData(lstate.batch_index);
+}
+
+static TableFunction MakeZeekScanFunction(const LogicalType &files_type) {
+	TableFunction func("read_zeek", {files_type}, ZeekScanExecute, ZeekScanBind, ZeekScanInitGlobal,
 	                   ZeekScanInitLocal);
 	func.named_parameters["filename"] = LogicalType::BOOLEAN;
 	func.named_parameters["replace_periods"] = LogicalType::BOOLEAN;
 	func.named_parameters["inet"] = LogicalType::BOOLEAN;
 	func.named_parameters["union_by_name"] = LogicalType::BOOLEAN;
 	func.named_parameters["ignore_file_errors"] = LogicalType::BOOLEAN;
+	func.named_parameters["parallel_decompression"] = LogicalType::BOOLEAN;
+	func.named_parameters["buffer_size"] = LogicalType::UBIGINT;
+	func.named_parameters["zero_copy"] = LogicalType::BOOLEAN;
+	func.named_parameters["ts_lag"] = LogicalType::INTERVAL;
+	func.named_parameters["ts_lead"] = LogicalType::INTERVAL;
+	func.named_parameters["use_index"] = LogicalType::BOOLEAN;
+	func.named_parameters["dictionary_columns"] = LogicalType::LIST(LogicalType::VARCHAR);
+	func.named_parameters["since"] = LogicalType::MAP(LogicalType::VARCHAR, LogicalType::UBIGINT);
+	func.named_parameters["cache_dir"] = LogicalType::VARCHAR;
+	func.named_parameters["sample"] = LogicalType::DOUBLE;
+	func.bind_replace = ZeekCache::BindReplace;
 	func.projection_pushdown = true;
 	func.filter_pushdown = true;
 	func.supports_pushdown_type = ZeekSupportsPushdownType;
+	func.cardinality = ZeekScanCardinality;
+	func.table_scan_progress = ZeekScanProgress;
+	func.statistics = ZeekScanStatistics;
+	func.dynamic_to_string = ZeekScanDynamicToString;
+	func.get_partition_data = ZeekScanGetPartitionData;
 	return func;
 }
 
+TableFunctionSet GetZeekScanFunction() {
+	TableFunctionSet set("read_zeek");
+	set.AddFunction(MakeZeekScanFunction(LogicalType::VARCHAR));
+	set.AddFunction(MakeZeekScanFunction(LogicalType::LIST(LogicalType::VARCHAR)));
+	return set;
+}
+
 } // namespace duckdb
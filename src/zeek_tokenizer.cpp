@@ -0,0 +1,392 @@
+#include "zeek_tokenizer.hpp"
+#include "duckdb/common/bit_utils.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define ZEEK_TOKENIZER_X86 1
+// The AVX2 kernel needs per-function target attributes and __builtin_cpu_supports.
+#if defined(__GNUC__) || defined(__clang__)
+#define ZEEK_TOKENIZER_AVX2 1
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ZEEK_TOKENIZER_NEON 1
+#endif
+
+namespace duckdb {
+
+static constexpr idx_t TOKENIZER_BLOCK_SIZE = 64;
+
+//! Offset of the first newline in data[from, len), or len if there is none.
+static inline idx_t FindNewline(const char *data, idx_t from, idx_t len) {
+	if (from >= len) {
+		return len;
+	}
+	auto newline = static_cast<const char *>(std::memchr(data + from, '\n', len - from));
+	return newline ? static_cast<idx_t>(newline - data) : len;
+}
+
+//! Append the fields that end within one block. Bit i of `newlines` / `separators` is set if byte
+//! `base + i` of the line is a newline / separator. Returns true, with `line_end` set, if the block
+//! holds the newline that ends the line, or once `max_fields` fields have been appended (in which
+//! case the rest of the line is only searched for its newline).
+static inline bool ConsumeBlockMasks(const char *data, idx_t len, idx_t base, uint64_t newlines,
+                                     uint64_t separators, idx_t max_fields, idx_t &field_start,
+                                     vector<FieldSlice> &slices, idx_t &line_end) {
+	if (newlines) {
+		// Separators after the newline belong to the next line.
+		separators &= (newlines & (~newlines + 1)) - 1;
+	}
+	while (separators) {
+		const idx_t pos = base + CountZeros<uint64_t>::Trailing(separators);
+		slices.push_back({data + field_start, static_cast<uint32_t>(pos - field_start)});
+		field_start = pos + 1;
+		separators &= separators - 1;
+		if (slices.size() == max_fields) {
+			line_end = newlines ? base + CountZeros<uint64_t>::Trailing(newlines)
+			                    : FindNewline(data, base + TOKENIZER_BLOCK_SIZE, len);
+			return true;
+		}
+	}
+	if (newlines) {
+		line_end = base + CountZeros<uint64_t>::Trailing(newlines);
+		slices.push_back({data + field_start, static_cast<uint32_t>(line_end - field_start)});
+		return true;
+	}
+	return false;
+}
+
+static inline idx_t CountOnes(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<idx_t>(__builtin_popcountll(mask));
+#else
+	idx_t count = 0;
+	for (; mask; mask &= mask - 1) {
+		count++;
+	}
+	return count;
+#endif
+}
+
+// The block loops below are inlined into each ISA's wrapper, whose target attribute then lets the
+// compiler inline that ISA's block masks into the loop.
+#if defined(__GNUC__) || defined(__clang__)
+#define ZEEK_TOKENIZER_INLINE __attribute__((always_inline)) inline
+#else
+#define ZEEK_TOKENIZER_INLINE inline
+#endif
+
+//! Compute the masks of the 64-byte block at `base` of the span with `block_masks`. The final partial
+//! block is copied into a zero-padded buffer, and the bits past the end of the span are masked off.
+//! Returns the number of bytes of the span in the block.
+template <class BLOCK_MASKS>
+static ZEEK_TOKENIZER_INLINE idx_t SpanBlockMasks(const BLOCK_MASKS &block_masks, const char *data, idx_t len,
+                                                  idx_t base, char separator, uint64_t &newlines,
+                                                  uint64_t &separators) {
+	const idx_t remaining = len - base;
+	if (remaining >= TOKENIZER_BLOCK_SIZE) {
+		block_masks(data + base, separator, newlines, separators);
+		return TOKENIZER_BLOCK_SIZE;
+	}
+	char tail[TOKENIZER_BLOCK_SIZE];
+	std::memcpy(tail, data + base, remaining);
+	std::memset(tail + remaining, 0, TOKENIZER_BLOCK_SIZE - remaining);
+	block_masks(tail, separator, newlines, separators);
+	const uint64_t valid = (uint64_t(1) << remaining) - 1;
+	newlines &= valid;
+	separators &= valid;
+	return remaining;
+}
+
+//! Split the line at the start of the span into fields, 64 bytes at a time (see
+//! ZeekTokenizer::TokenizeLine).
+template <class BLOCK_MASKS>
+static ZEEK_TOKENIZER_INLINE idx_t TokenizeBlocks(const char *data, idx_t len, char separator, idx_t max_fields,
+                                                  vector<FieldSlice> &slices) {
+	const BLOCK_MASKS block_masks;
+	slices.clear();
+	idx_t field_start = 0;
+	idx_t line_end = 0;
+	uint64_t newlines, separators;
+	for (idx_t base = 0; base < len; base += TOKENIZER_BLOCK_SIZE) {
+		SpanBlockMasks(block_masks, data, len, base, separator, newlines, separators);
+		if (ConsumeBlockMasks(data, len, base, newlines, separators, max_fields, field_start, slices, line_end)) {
+			return line_end;
+		}
+	}
+	slices.push_back({data + field_start, static_cast<uint32_t>(len - field_start)});
+	return len;
+}
+
+//! Count the occurrences of `separator` in the span, 64 bytes at a time.
+template <class BLOCK_MASKS>
+static ZEEK_TOKENIZER_INLINE idx_t CountSeparatorBlocks(const char *data, idx_t len, char separator) {
+	const BLOCK_MASKS block_masks;
+	idx_t count = 0;
+	uint64_t newlines, separators;
+	for (idx_t base = 0; base < len; base += TOKENIZER_BLOCK_SIZE) {
+		SpanBlockMasks(block_masks, data, len, base, separator, newlines, separators);
+		count += CountOnes(separators);
+	}
+	return count;
+}
+
+//! Count the rows among the lines starting in the span (see ZeekTokenizer::CountRows), using the block
+//! masks with '#' as the separator to find the newlines and comment markers of 64 bytes at a time. A
+//! byte starts a line if it follows a newline; it starts a row unless it is a newline itself (an empty
+//! line) or a '#'. A one-byte line may be a lone '\r' (an empty "\r\n" line), as may a line starting
+//! in the last byte of a block, so those starts are checked individually.
+template <class BLOCK_MASKS>
+static ZEEK_TOKENIZER_INLINE idx_t CountRowBlocks(const char *data, idx_t len, idx_t max_rows, idx_t &consumed) {
+	const BLOCK_MASKS block_masks;
+	bool unresolved = false;
+	idx_t rows = 0;
+	uint64_t carry = 1;
+	uint64_t newlines, hashes;
+	for (idx_t base = 0; base < len; base += TOKENIZER_BLOCK_SIZE) {
+		const idx_t block_len = SpanBlockMasks(block_masks, data, len, base, '#', newlines, hashes);
+		const uint64_t valid = block_len == TOKENIZER_BLOCK_SIZE ? ~uint64_t(0) : (uint64_t(1) << block_len) - 1;
+		const uint64_t starts = ((newlines << 1) | carry) & valid;
+		carry = newlines >> 63;
+		uint64_t candidates = starts & ~newlines & ~hashes;
+		uint64_t unclear = candidates & ((newlines >> 1) | (uint64_t(1) << (block_len - 1)));
+		while (unclear) {
+			const idx_t bit = CountZeros<uint64_t>::Trailing(unclear);
+			unclear &= unclear - 1;
+			const idx_t pos = base + bit;
+			if (data[pos] != '\r') {
+				continue;
+			}
+			if (pos + 1 == len) {
+				candidates &= ~(uint64_t(1) << bit);
+				unresolved = true;
+			} else if (data[pos + 1] == '\n') {
+				candidates &= ~(uint64_t(1) << bit);
+			}
+		}
+		const idx_t count = CountOnes(candidates);
+		if (rows + count > max_rows) {
+			for (idx_t skip = max_rows - rows; skip > 0; skip--) {
+				candidates &= candidates - 1;
+			}
+			consumed = base + CountZeros<uint64_t>::Trailing(candidates);
+			return max_rows;
+		}
+		rows += count;
+	}
+	consumed = unresolved ? len - 1 : len;
+	return rows;
+}
+
+#undef ZEEK_TOKENIZER_INLINE
+
+//! Portable version of the vector kernels' block masks, for the row counter on other platforms.
+struct BlockMasksScalar {
+	inline void operator()(const char *block, char separator, uint64_t &newlines, uint64_t &separators) const {
+		newlines = 0;
+		separators = 0;
+		for (idx_t i = 0; i < TOKENIZER_BLOCK_SIZE; i++) {
+			newlines |= uint64_t(block[i] == '\n') << i;
+			separators |= uint64_t(block[i] == separator) << i;
+		}
+	}
+};
+
+#if !defined(ZEEK_TOKENIZER_X86) && !defined(ZEEK_TOKENIZER_NEON)
+static idx_t CountRowsScalar(const char *data, idx_t len, idx_t max_rows, idx_t &consumed) {
+	return CountRowBlocks<BlockMasksScalar>(data, len, max_rows, consumed);
+}
+#endif
+
+static idx_t CountSeparatorsScalar(const char *data, idx_t len, char separator) {
+	idx_t count = 0;
+	for (idx_t i = 0; i < len; i++) {
+		count += data[i] == separator;
+	}
+	return count;
+}
+
+static idx_t TokenizeLineScalar(const char *data, idx_t len, char separator, idx_t max_fields,
+                                vector<FieldSlice> &slices) {
+	slices.clear();
+	idx_t field_start = 0;
+	for (idx_t i = 0; i < len; i++) {
+		if (data[i] == separator) {
+			slices.push_back({data + field_start, static_cast<uint32_t>(i - field_start)});
+			field_start = i + 1;
+			if (slices.size() == max_fields) {
+				return FindNewline(data, field_start, len);
+			}
+		} else if (data[i] == '\n') {
+			slices.push_back({data + field_start, static_cast<uint32_t>(i - field_start)});
+			return i;
+		}
+	}
+	slices.push_back({data + field_start, static_cast<uint32_t>(len - field_start)});
+	return len;
+}
+
+#ifdef ZEEK_TOKENIZER_X86
+struct BlockMasksSSE2 {
+	inline void operator()(const char *block, char separator, uint64_t &newlines, uint64_t &separators) const {
+		const __m128i nl = _mm_set1_epi8('\n');
+		const __m128i sep = _mm_set1_epi8(separator);
+		newlines = 0;
+		separators = 0;
+		for (idx_t i = 0; i < TOKENIZER_BLOCK_SIZE; i += 16) {
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+			newlines |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, nl)))) << i;
+			separators |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, sep)))) << i;
+		}
+	}
+};
+
+static idx_t TokenizeLineSSE2(const char *data, idx_t len, char separator, idx_t max_fields,
+                              vector<FieldSlice> &slices) {
+	return TokenizeBlocks<BlockMasksSSE2>(data, len, separator, max_fields, slices);
+}
+
+static idx_t CountRowsSSE2(const char *data, idx_t len, idx_t max_rows, idx_t &consumed) {
+	return CountRowBlocks<BlockMasksSSE2>(data, len, max_rows, consumed);
+}
+
+static idx_t CountSeparatorsSSE2(const char *data, idx_t len, char separator) {
+	return CountSeparatorBlocks<BlockMasksSSE2>(data, len, separator);
+}
+#endif
+
+#ifdef ZEEK_TOKENIZER_AVX2
+struct BlockMasksAVX2 {
+	__attribute__((target("avx2"))) inline void operator()(const char *block, char separator, uint64_t &newlines,
+	                                                       uint64_t &separators) const {
+		const __m256i nl = _mm256_set1_epi8('\n');
+		const __m256i sep = _mm256_set1_epi8(separator);
+		const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+		const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+		newlines = uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, nl)))) |
+		           uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, nl)))) << 32;
+		separators = uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, sep)))) |
+		             uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, sep)))) << 32;
+	}
+};
+
+__attribute__((target("avx2"))) static idx_t TokenizeLineAVX2(const char *data, idx_t len, char separator,
+                                                               idx_t max_fields, vector<FieldSlice> &slices) {
+	return TokenizeBlocks<BlockMasksAVX2>(data, len, separator, max_fields, slices);
+}
+
+__attribute__((target("avx2"))) static idx_t CountRowsAVX2(const char *data, idx_t len, idx_t max_rows,
+                                                            idx_t &consumed) {
+	return CountRowBlocks<BlockMasksAVX2>(data, len, max_rows, consumed);
+}
+
+__attribute__((target("avx2"))) static idx_t CountSeparatorsAVX2(const char *data, idx_t len, char separator) {
+	return CountSeparatorBlocks<BlockMasksAVX2>(data, len, separator);
+}
+#endif
+
+#ifdef ZEEK_TOKENIZER_NEON
+//! Collapse four 16-byte comparison results (0x00 / 0xFF per byte) into a 64-bit mask.
+static inline uint64_t MoveMaskNEON(uint8x16_t c0, uint8x16_t c1, uint8x16_t c2, uint8x16_t c3) {
+	static const uint8_t BIT_WEIGHTS[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+	                                        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+	const uint8x16_t weights = vld1q_u8(BIT_WEIGHTS);
+	uint8x16_t sum0 = vpaddq_u8(vandq_u8(c0, weights), vandq_u8(c1, weights));
+	const uint8x16_t sum1 = vpaddq_u8(vandq_u8(c2, weights), vandq_u8(c3, weights));
+	sum0 = vpaddq_u8(sum0, sum1);
+	sum0 = vpaddq_u8(sum0, sum0);
+	return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+struct BlockMasksNEON {
+	inline void operator()(const char *block, char separator, uint64_t &newlines, uint64_t &separators) const {
+		const uint8x16_t nl = vdupq_n_u8('\n');
+		const uint8x16_t sep = vdupq_n_u8(static_cast<uint8_t>(separator));
+		const uint8_t *bytes = reinterpret_cast<const uint8_t *>(block);
+		const uint8x16_t b0 = vld1q_u8(bytes);
+		const uint8x16_t b1 = vld1q_u8(bytes + 16);
+		const uint8x16_t b2 = vld1q_u8(bytes + 32);
+		const uint8x16_t b3 = vld1q_u8(bytes + 48);
+		newlines = MoveMaskNEON(vceqq_u8(b0, nl), vceqq_u8(b1, nl), vceqq_u8(b2, nl), vceqq_u8(b3, nl));
+		separators = MoveMaskNEON(vceqq_u8(b0, sep), vceqq_u8(b1, sep), vceqq_u8(b2, sep), vceqq_u8(b3, sep));
+	}
+};
+
+static idx_t TokenizeLineNEON(const char *data, idx_t len, char separator, idx_t max_fields,
+                              vector<FieldSlice> &slices) {
+	return TokenizeBlocks<BlockMasksNEON>(data, len, separator, max_fields, slices);
+}
+
+static idx_t CountRowsNEON(const char *data, idx_t len, idx_t max_rows, idx_t &consumed) {
+	return CountRowBlocks<BlockMasksNEON>(data, len, max_rows, consumed);
+}
+
+static idx_t CountSeparatorsNEON(const char *data, idx_t len, char separator) {
+	return CountSeparatorBlocks<BlockMasksNEON>(data, len, separator);
+}
+#endif
+
+typedef idx_t (*tokenize_line_t)(const char *data, idx_t len, char separator, idx_t max_fields,
+                                 vector<FieldSlice> &slices);
+typedef idx_t (*count_rows_t)(const char *data, idx_t len, idx_t max_rows, idx_t &consumed);
+typedef idx_t (*count_separators_t)(const char *data, idx_t len, char separator);
+
+struct TokenizerKernel {
+	tokenize_line_t function;
+	count_rows_t count_rows;
+	count_separators_t count_separators;
+	const char *name;
+};
+
+static TokenizerKernel SelectKernel() {
+#ifdef ZEEK_TOKENIZER_AVX2
+	if (__builtin_cpu_supports("avx2")) {
+		return {TokenizeLineAVX2, CountRowsAVX2, CountSeparatorsAVX2, "avx2"};
+	}
+#endif
+#if defined(ZEEK_TOKENIZER_X86)
+	return {TokenizeLineSSE2, CountRowsSSE2, CountSeparatorsSSE2, "sse2"};
+#elif defined(ZEEK_TOKENIZER_NEON)
+	return {TokenizeLineNEON, CountRowsNEON, CountSeparatorsNEON, "neon"};
+#else
+	return {TokenizeLineScalar, CountRowsScalar, CountSeparatorsScalar, "scalar"};
+#endif
+}
+
+static const TokenizerKernel &GetKernel() {
+	static const TokenizerKernel kernel = SelectKernel();
+	return kernel;
+}
+
+idx_t ZeekTokenizer::TokenizeLine(const char *data, idx_t len, char separator, vector<FieldSlice> &slices,
+                                  idx_t max_fields) {
+	if (max_fields == 0) {
+		slices.clear();
+		return FindNewline(data, 0, len);
+	}
+	if (separator == '\n' || separator == '\0') {
+		// Degenerate separators collide with the newline / zero padding used by the vector kernels.
+		return TokenizeLineScalar(data, len, separator, max_fields, slices);
+	}
+	return GetKernel().function(data, len, separator, max_fields, slices);
+}
+
+idx_t ZeekTokenizer::CountRows(const char *data, idx_t len, idx_t max_rows, idx_t &consumed) {
+	return GetKernel().count_rows(data, len, max_rows, consumed);
+}
+
+idx_t ZeekTokenizer::CountSeparators(const char *data, idx_t len, char separator) {
+	if (len < TOKENIZER_BLOCK_SIZE || separator == '\0') {
+		// Short spans (most list cells) aren't worth a padded block, and '\0' matches the padding.
+		return CountSeparatorsScalar(data, len, separator);
+	}
+	return GetKernel().count_separators(data, len, separator);
+}
+
+const char *ZeekTokenizer::KernelName() {
+	return GetKernel().name;
+}
+
+} // namespace duckdb